@@ -48,7 +48,14 @@
 
 int main(int argc, char ** argv)
 {
-    HGPU_GPU_test(argc,argv);
+    HGPU_parameter** parameters = HGPU_parameters_get_all(argc,argv);
+    bool stream_mode = (HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_STREAM) != NULL);
+    HGPU_parameters_delete(&parameters);
+
+    if (stream_mode)
+        HGPU_GPU_stream(argc,argv);     // raw PRNs to stdout (PRNG_STREAM=bytes, 0 = endless)
+    else
+        HGPU_GPU_test(argc,argv);
 
 //    HGPU_GPU_example_pi(argc,argv);
 
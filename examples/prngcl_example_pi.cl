@@ -38,25 +38,24 @@
 #ifndef PRNGCL_EXAMPLE_PI_CL
 #define PRNGCL_EXAMPLE_PI_CL
 
-#include "prngcl_common.cl"
+#include "prngcl_device.cl"
 
 __kernel void
-calculate_pi(__global hgpu_float4* randoms,
+calculate_pi(__global prng_seed_t* seed_table,
              __global float* acceptance,
              const uint N)
 {
-    uint index = GID;
     float count = 0;
     hgpu_float4 rnd,rnd2;
+    prng_state state = prng_state_load(seed_table);
 
     for (uint i=0; i<N; i++) {
-        rnd = randoms[index];
+        rnd = prng_next_float4(&state);
         rnd2 = rnd * rnd;
         if ((rnd2.x+rnd2.y) <= 1.0) count += 1.0;
         if ((rnd2.z+rnd2.w) <= 1.0) count += 1.0;
-
-        index += GID_SIZE;
     }
+    prng_state_store(seed_table,&state);
     acceptance[GID] += count;
 }
 
@@ -73,14 +73,10 @@ HGPU_GPU_example_pi(int argc, char** argv){
     
     HGPU_PRNG* prng = HGPU_PRNG_new(prng_descr); // create new PRNG instance
 
-    unsigned int prng_id = HGPU_PRNG_init(context,prng); // PRNG initialization
+    HGPU_PRNG_init_device_api(context,prng); // PRNG initialization (PRNs are produced inside calculate_pi kernel)
 
     char* example_src = HGPU_io_file_read_with_path(HGPU_io_path_root,EXAMPLE_SRC); // get .cl-source of example
-    char options[HGPU_GPU_MAX_OPTIONS_LENGTH];
-    int  j2 = sprintf_s(options,HGPU_GPU_MAX_OPTIONS_LENGTH,"-I %s%s",HGPU_io_path_root,PRNGCL_ROOT_PATH);
-    if (prng->parameters->precision==HGPU_precision_double) j2 += sprintf_s(options+j2,HGPU_GPU_MAX_OPTIONS_LENGTH-j2," -D PRNG_PRECISION=2");
-
-    cl_program prg = HGPU_GPU_program_with_options_new(example_src,options,context); // compile opencl program
+    cl_program prg = HGPU_PRNG_program_new(context,prng,example_src); // compile opencl program together with PRNG source
 
     // allocated memory objects
     size_t pi_acceptance_size = HGPU_GPU_context_buffer_size_align(context,prng->parameters->instances); // align buffer size
@@ -88,26 +84,21 @@ HGPU_GPU_example_pi(int argc, char** argv){
     if (!pi_acceptance)
         HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for randoms"); // chech if buffer is allocated
 
-    unsigned int PRNG_randoms_id = prng->parameters->id_buffer_randoms; // get randoms buffer id
-
     // buffer OpenCL initialization
     unsigned int pi_acceptance_id = HGPU_GPU_context_buffer_init(context,pi_acceptance,HGPU_GPU_buffer_type_io,pi_acceptance_size,sizeof(cl_float));
     HGPU_GPU_context_buffer_set_name(context,pi_acceptance_id,(char*) "PI_Acceptance"); // [optional]: set name to buffer for profiling/debugging
 
     unsigned int kernel_pi_calculate_id = HGPU_GPU_MAX_KERNELS;
     const size_t global_size[]  = {prng->parameters->instances}; // execution domain
-    if ((pi_acceptance_id<HGPU_GPU_MAX_BUFFERS) && (PRNG_randoms_id<HGPU_GPU_MAX_BUFFERS) && (prng->prng->production_kernel)) {
+    if (pi_acceptance_id<HGPU_GPU_MAX_BUFFERS) {
         // bind buffers and number of samples (PRNs) per stream to the kernel
         kernel_pi_calculate_id = HGPU_GPU_context_kernel_init(context,prg,"calculate_pi",1,global_size,NULL); // prepare kernel
-                     HGPU_GPU_context_kernel_bind_buffer(context,kernel_pi_calculate_id,PRNG_randoms_id);     // bind buffer with randoms
+                     HGPU_PRNG_kernel_bind_seeds(context,kernel_pi_calculate_id,prng);                         // bind PRNG seed table
                      HGPU_GPU_context_kernel_bind_buffer(context,kernel_pi_calculate_id,pi_acceptance_id);    // bind buffer for results
                      HGPU_GPU_context_kernel_bind_constant(context,kernel_pi_calculate_id,&samples_per_stream,sizeof(unsigned int)); // bind samples_per_stream
     }
 
-    for (unsigned int i=0; i<passes; i++) {
-        HGPU_PRNG_produce(context,prng_id);  // produce PRNs into randoms array
-        HGPU_GPU_context_kernel_run(context,kernel_pi_calculate_id); // run pi calculation kernel
-    }
+    HGPU_PRNG_produce_n(context,prng,passes,kernel_pi_calculate_id); // run pi calculation kernel passes times (PRNs are produced inline)
 
     cl_float* results_ptr = (cl_float*) HGPU_GPU_context_buffer_get_mapped(context,pi_acceptance_id);
 
@@ -57,3 +57,38 @@ HGPU_GPU_test(int argc, char** argv){
     HGPU_parameters_delete(&parameters_all);  // free parameters
     HGPU_GPU_context_delete(&context);        // release context
 }
+
+// stream raw PRNs to stdout (PRNG_STREAM = number of bytes, 0 = endless) for external test batteries:
+// e.g. "PRNGCL.amd -PRNG_STREAM=0 | RNG_test stdin32"; all messages of library are redirected to stderr
+void
+HGPU_GPU_stream(int argc, char** argv){
+    HGPU_parameter** parameters_all = HGPU_parameters_get_all(argc,argv);
+
+    fflush(stdout);
+    FILE* stream = _fdopen(_dup(_fileno(stdout)),"wb");
+    _dup2(_fileno(stderr),_fileno(stdout));
+    if (!stream) HGPU_error_message(HGPU_ERROR_FILE_NOT_FOUND,"could not open stdout for PRNs");
+#ifdef _WIN32
+    _setmode(_fileno(stream),_O_BINARY);
+#endif
+
+    llu_T bytes = 0;
+    HGPU_parameter* parameter_stream = HGPU_parameters_get_by_name(parameters_all,(char*) HGPU_PARAMETER_PRNG_STREAM);
+    if (parameter_stream && (parameter_stream->value_text)) sscanf_s(parameter_stream->value_text,"%llu",&bytes);
+
+    HGPU_GPU_context* context = HGPU_GPU_context_select_auto(parameters_all);
+    HGPU_PRNG* prng = HGPU_PRNG_new(HGPU_PRNG_description_get_with_parameters(parameters_all));
+    HGPU_PRNG_set_with_parameters(prng,parameters_all);
+    HGPU_PRNG_init(context,prng);
+
+    HGPU_timer timer = HGPU_timer_start();
+    u64_T written = HGPU_PRNG_write_output_binary_stream(context,prng,stream,bytes);
+    double elapsed = HGPU_timer_get(timer);
+    fprintf(stderr,"%s: %llu bytes streamed (%f Mbytes/sec)\n",prng->prng->name,(llu_T) written,
+            (elapsed>0.0) ? HGPU_convert_B_to_MB((double) written) / elapsed : 0.0);
+    if (fclose(stream)) HGPU_error_note(HGPU_ERROR_FILE_NOT_CLOSED,"the stream was not closed");
+
+    HGPU_PRNG_and_buffers_free(context,prng);
+    HGPU_parameters_delete(&parameters_all);  // free parameters
+    HGPU_GPU_context_delete(&context);        // release context
+}
@@ -59,6 +59,7 @@
 #include "../randomcl/hgpu_prng.h"
 
                    void   HGPU_GPU_test(int argc, char** argv);
+                   void   HGPU_GPU_stream(int argc, char** argv);
 
 
 #endif
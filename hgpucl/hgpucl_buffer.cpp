@@ -108,12 +108,31 @@ HGPU_GPU_buffer_delete(HGPU_GPU_buffer** buffer){
     (*buffer) = NULL;
 }
 
+#ifdef CL_VERSION_1_1
+// free page-aligned host memory of zero-copy buffer (destructor callback of cl_mem object)
+static void CL_CALLBACK
+HGPU_GPU_buffer_host_free_callback(cl_mem,void* host_ptr){
+    HGPU_GPU_buffer_host_free_aligned(host_ptr);
+}
+#endif
+
 // release buffer (free, but do not delete (HGPU_GPU_buffer*) structure)
 void
 HGPU_GPU_buffer_release(HGPU_GPU_buffer* buffer){
     if (!buffer) return;
+    if ((buffer->buffer) && (buffer->host_ptr)) {
+        // device could still use host memory of zero-copy buffer (commands in queue),
+        // so it is freed only after cl_mem object is destroyed by OpenCL runtime
+#ifdef CL_VERSION_1_1
+        HGPU_GPU_error_message(clSetMemObjectDestructorCallback(buffer->buffer,&HGPU_GPU_buffer_host_free_callback,buffer->host_ptr),"clSetMemObjectDestructorCallback failed");
+        buffer->host_ptr = NULL;
+#else
+        HGPU_GPU_buffer_wait_for_event(&buffer->buffer_read_event);
+        HGPU_GPU_buffer_wait_for_event(&buffer->buffer_write_event);
+#endif
+    }
     if (buffer->buffer) HGPU_GPU_buffer_mem_release(buffer->buffer);
-    free(buffer->host_ptr);
+    HGPU_GPU_buffer_host_free_aligned(buffer->host_ptr);
     free(buffer->name);
     buffer->buffer   = NULL;
     buffer->host_ptr = NULL;
@@ -123,6 +142,8 @@ HGPU_GPU_buffer_release(HGPU_GPU_buffer* buffer){
     buffer->size           = 0;
     buffer->sizeof_element = 0;
 
+    if (buffer->buffer_write_event) clReleaseEvent(buffer->buffer_write_event);
+    if (buffer->buffer_read_event)  clReleaseEvent(buffer->buffer_read_event);
     buffer->buffer_write_event   = 0;
     buffer->buffer_read_event    = 0;
     buffer->buffer_write_start   = 0;
@@ -163,11 +184,76 @@ HGPU_GPU_buffer_get_by_index(HGPU_GPU_buffer** buffers,unsigned int index){
 unsigned int
 HGPU_GPU_buffer_init(HGPU_GPU_buffer*** buffers,cl_context context,void* host_ptr_to_buffer,
                      HGPU_GPU_buffer_types buffer_type,size_t buffer_elements,size_t sizeof_element){
-    if (!host_ptr_to_buffer) return HGPU_GPU_MAX_BUFFERS;
+    return HGPU_GPU_buffer_init_pooled(buffers,context,NULL,NULL,host_ptr_to_buffer,buffer_type,buffer_elements,sizeof_element);
+}
+
+// buffer initialization with cl_mem object recycled from pool (if any);
+// recycled buffer is filled with host data by blocking write to queue instead of CL_MEM_COPY_HOST_PTR;
+// host memory (host_ptr_to_buffer) is owned by buffer: it is freed (or moved to pool) right after upload,
+// buffers without initialization (output, global, device) do not need host memory at all (host_ptr_to_buffer could be NULL)
+unsigned int
+HGPU_GPU_buffer_init_pooled(HGPU_GPU_buffer*** buffers,cl_context context,cl_command_queue queue,HGPU_GPU_buffer_pool* pool,
+                     void* host_ptr_to_buffer,HGPU_GPU_buffer_types buffer_type,size_t buffer_elements,size_t sizeof_element){
+    cl_mem_flags flags = HGPU_GPU_buffer_get_flags(buffer_type);
+    if ((!host_ptr_to_buffer) && (flags & CL_MEM_COPY_HOST_PTR)) return HGPU_GPU_MAX_BUFFERS;
     HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_new_empty();
-    buffer->host_ptr = host_ptr_to_buffer;
 
     cl_mem clbuffer = NULL;
+    void* host_ptr = (flags & CL_MEM_COPY_HOST_PTR) ? host_ptr_to_buffer : NULL;
+    buffer->buffer_type    = buffer_type;
+    buffer->size           = buffer_elements;
+    buffer->sizeof_element = sizeof_element;
+
+    size_t size = buffer_elements*sizeof_element;
+    if ((pool) && (queue) && (buffer_type!=HGPU_GPU_buffer_type_local))
+        clbuffer = HGPU_GPU_buffer_pool_get(pool,flags,size);
+    if (clbuffer) {
+        if (host_ptr)
+            HGPU_GPU_error_message(clEnqueueWriteBuffer(queue,clbuffer,CL_TRUE,0,size,host_ptr,0,NULL,NULL),"clEnqueueWriteBuffer failed");
+    } else if (buffer_type!=HGPU_GPU_buffer_type_local)
+        clbuffer = HGPU_GPU_buffer_create(context,flags,size,host_ptr);
+    buffer->buffer = clbuffer;
+    HGPU_GPU_buffer_pool_host_free(pool,host_ptr_to_buffer,size);
+
+    HGPU_GPU_buffers_add(&(*buffers),buffer);
+    unsigned int result = HGPU_GPU_buffer_get_index(*buffers,buffer);
+
+    return result;
+}
+
+// zero-copy buffer initialization (for devices with unified memory): device uses page-aligned host memory in place
+// (CL_MEM_USE_HOST_PTR), so mapping of buffer does not copy data; host data (host_ptr_to_buffer) is copied into it
+// and freed (or moved to pool) as for HGPU_GPU_buffer_init_pooled
+unsigned int
+HGPU_GPU_buffer_init_zero_copy(HGPU_GPU_buffer*** buffers,cl_context context,HGPU_GPU_buffer_pool* pool,
+                     void* host_ptr_to_buffer,HGPU_GPU_buffer_types buffer_type,size_t buffer_elements,size_t sizeof_element){
+    cl_mem_flags flags = HGPU_GPU_buffer_get_flags(buffer_type);
+    if ((!host_ptr_to_buffer) && (flags & CL_MEM_COPY_HOST_PTR)) return HGPU_GPU_MAX_BUFFERS;
+    size_t size = buffer_elements*sizeof_element;
+    size_t size_aligned = HGPU_GPU_buffer_size_align_step(size,HGPU_GPU_ZERO_COPY_SIZE_STEP);
+    void* host_ptr = HGPU_GPU_buffer_host_alloc_aligned(size_aligned);
+    if (!host_ptr) HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for zero-copy buffer");
+    if (flags & CL_MEM_COPY_HOST_PTR)
+        memcpy(host_ptr,host_ptr_to_buffer,size);
+    HGPU_GPU_buffer_pool_host_free(pool,host_ptr_to_buffer,size);
+
+    HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_new_empty();
+    flags = (flags & ~(CL_MEM_COPY_HOST_PTR | CL_MEM_ALLOC_HOST_PTR)) | CL_MEM_USE_HOST_PTR;
+    buffer->buffer_type    = buffer_type;
+    buffer->size           = buffer_elements;
+    buffer->sizeof_element = sizeof_element;
+    buffer->host_ptr       = host_ptr;
+    buffer->buffer         = HGPU_GPU_buffer_create(context,flags,size_aligned,host_ptr);
+
+    HGPU_GPU_buffers_add(&(*buffers),buffer);
+    unsigned int result = HGPU_GPU_buffer_get_index(*buffers,buffer);
+
+    return result;
+}
+
+// get cl_mem flags for buffer type
+cl_mem_flags
+HGPU_GPU_buffer_get_flags(HGPU_GPU_buffer_types buffer_type){
     cl_mem_flags flags = 0;
     switch (buffer_type) {
         // CL_MEM_USE_HOST_PTR
@@ -178,22 +264,12 @@ HGPU_GPU_buffer_init(HGPU_GPU_buffer*** buffers,cl_context context,void* host_pt
         case HGPU_GPU_buffer_type_io:		{ flags = CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR | CL_MEM_ALLOC_HOST_PTR; break;} // CL_MEM_COPY_HOST_PTR - or - CL_MEM_USE_HOST_PTR
         case HGPU_GPU_buffer_type_output:	{ flags = CL_MEM_WRITE_ONLY;                        break;} // 
         case HGPU_GPU_buffer_type_global:	{ flags = CL_MEM_READ_WRITE;                        break;}
+        case HGPU_GPU_buffer_type_device:	{ flags = CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR; break;} // CL_MEM_ALLOC_HOST_PTR - for mapping
         case HGPU_GPU_buffer_type_local:    { break;}
         case HGPU_GPU_buffer_type_uav:      { break;}
         case HGPU_GPU_buffer_type_none:     { break;}
     }
-    buffer->buffer_type    = buffer_type;
-    buffer->size           = buffer_elements;
-    buffer->sizeof_element = sizeof_element;
-
-    if (buffer_type!=HGPU_GPU_buffer_type_local)
-        clbuffer = HGPU_GPU_buffer_create(context,flags,buffer_elements*sizeof_element,host_ptr_to_buffer);
-    buffer->buffer = clbuffer;
-
-    HGPU_GPU_buffers_add(&(*buffers),buffer);
-    unsigned int result = HGPU_GPU_buffer_get_index(*buffers,buffer);
-
-    return result;
+    return flags;
 }
 
 // set literal name for buffer (for debugging and statistics purposes)
@@ -215,9 +291,16 @@ HGPU_GPU_buffer_map(HGPU_GPU_buffer* buffer,cl_command_queue queue){
     return result;
 }
 
-// buffer map (asynchronous)
+// buffer map (asynchronous): returns pointer, which is valid only after buffer_read_event completes
+// (see HGPU_GPU_buffer_map_wait, HGPU_GPU_buffer_map_is_complete)
 void*
 HGPU_GPU_buffer_map_async(HGPU_GPU_buffer* buffer,cl_command_queue queue){
+    return HGPU_GPU_buffer_map_async_wait_list(buffer,queue,0,NULL);
+}
+
+// buffer map (asynchronous), which starts after events_number events of wait list
+void*
+HGPU_GPU_buffer_map_async_wait_list(HGPU_GPU_buffer* buffer,cl_command_queue queue,cl_uint events_number,const cl_event* events){
     void* result = NULL;
     if (!buffer){
         HGPU_GPU_error_note(HGPU_ERROR_BAD_BUFFER,"Trying to use null-buffer!");
@@ -227,14 +310,39 @@ HGPU_GPU_buffer_map_async(HGPU_GPU_buffer* buffer,cl_command_queue queue){
     cl_int GPU_error = 0;
     cl_event buffer_event = NULL;
     size_t size = buffer->size*buffer->sizeof_element;
-    result = clEnqueueMapBuffer(queue,buffer->buffer,CL_TRUE,CL_MAP_READ|CL_MAP_WRITE,0,size,0,NULL,&buffer_event,&GPU_error);
+    result = clEnqueueMapBuffer(queue,buffer->buffer,CL_FALSE,CL_MAP_READ|CL_MAP_WRITE,0,size,events_number,events,&buffer_event,&GPU_error);
         HGPU_GPU_error_message(GPU_error,"clEnqueueMapBuffer failed");
+    HGPU_GPU_error_message(clFlush(queue),"clFlush failed");
+    if (buffer->buffer_read_event) HGPU_GPU_error_message(clReleaseEvent(buffer->buffer_read_event),"clReleaseEvent failed");
     buffer->buffer_read_event = buffer_event;
     buffer->buffer_read_number_of++;
     buffer->mapped_ptr = (unsigned int*) result;
     return result;
 }
 
+// wait for asynchronous buffer map and return mapped pointer
+void*
+HGPU_GPU_buffer_map_wait(HGPU_GPU_buffer* buffer){
+    void* result = NULL;
+    if (!buffer) return result;
+    HGPU_GPU_buffer_wait_for_event(&buffer->buffer_read_event);
+    result = buffer->mapped_ptr;
+    return result;
+}
+
+// check if asynchronous buffer map is completed (without waiting)
+bool
+HGPU_GPU_buffer_map_is_complete(HGPU_GPU_buffer* buffer){
+    bool result = false;
+    if (!buffer) return result;
+    if (!buffer->buffer_read_event) return true;
+    cl_int status = CL_COMPLETE;
+    HGPU_GPU_error_message(clGetEventInfo(buffer->buffer_read_event,CL_EVENT_COMMAND_EXECUTION_STATUS,sizeof(status),&status,NULL),"clGetEventInfo failed");
+    if (status<0) HGPU_GPU_error_message(status,"buffer map failed");
+    result = (status==CL_COMPLETE);
+    return result;
+}
+
 // buffer map with profiling
 void*
 HGPU_GPU_buffer_map_with_profiling(HGPU_GPU_buffer* buffer,cl_command_queue queue){
@@ -277,15 +385,23 @@ HGPU_GPU_buffer_unmap_with_profiling(HGPU_GPU_buffer* buffer,cl_command_queue qu
 // buffer unmap (asynchronous)
 void
 HGPU_GPU_buffer_unmap_async(HGPU_GPU_buffer* buffer,cl_command_queue queue,void* data_ptr){
+    HGPU_GPU_buffer_unmap_async_wait_list(buffer,queue,data_ptr,0,NULL);
+}
+
+// buffer unmap (asynchronous), which starts after events_number events of wait list
+void
+HGPU_GPU_buffer_unmap_async_wait_list(HGPU_GPU_buffer* buffer,cl_command_queue queue,void* data_ptr,cl_uint events_number,const cl_event* events){
     if (!buffer){
         HGPU_GPU_error_note(HGPU_ERROR_BAD_BUFFER,"Trying to use null-buffer!");
         return;
     }
 
     cl_event buffer_event = NULL;
-    HGPU_GPU_error_message(clEnqueueUnmapMemObject(queue,buffer->buffer,data_ptr,0,NULL,&buffer_event),"clEnqueueUnmapMemObject failed");
+    HGPU_GPU_error_message(clEnqueueUnmapMemObject(queue,buffer->buffer,data_ptr,events_number,events,&buffer_event),"clEnqueueUnmapMemObject failed");
+    if (buffer->buffer_write_event) HGPU_GPU_error_message(clReleaseEvent(buffer->buffer_write_event),"clReleaseEvent failed");
     buffer->buffer_write_event = buffer_event;
     buffer->buffer_write_number_of++;
+    if ((void*) buffer->mapped_ptr==data_ptr) buffer->mapped_ptr = NULL;
 }
 
 // profile buffer unmap
@@ -345,16 +461,152 @@ HGPU_GPU_buffer_mem_release(cl_mem buffer){
     HGPU_GPU_error_message(GPU_error,"clReleaseMemObject failed");
 }
 
+// allocate page-aligned host memory (for CL_MEM_USE_HOST_PTR buffers)
+void*
+HGPU_GPU_buffer_host_alloc_aligned(size_t size_in_bytes){
+    void* result = NULL;
+#ifdef _WIN32
+    result = _aligned_malloc(size_in_bytes,HGPU_GPU_ZERO_COPY_ALIGNMENT);
+#else
+    if (posix_memalign(&result,HGPU_GPU_ZERO_COPY_ALIGNMENT,size_in_bytes)) result = NULL;
+#endif
+    if (result) memset(result,0,size_in_bytes);
+    return result;
+}
+
+// free page-aligned host memory
+void
+HGPU_GPU_buffer_host_free_aligned(void* host_ptr){
+    if (!host_ptr) return;
+#ifdef _WIN32
+    _aligned_free(host_ptr);
+#else
+    free(host_ptr);
+#endif
+}
+
 // align buffer size
 size_t
 HGPU_GPU_buffer_size_align_step(size_t buffer_size,size_t step){
     return (1 + (buffer_size-1) / step) * step;
 }
 
+
+// buffer pool____________________________________________________________________________________________________
+
+// size class of pool (the nearest power of 2, which is not less than size)
+static size_t
+HGPU_GPU_buffer_pool_size_class(size_t size){
+    size_t result = 1;
+    while ((result<size) && (result<<1)) result <<= 1;
+    return result;
+}
+
+// new empty pool of buffers
+HGPU_GPU_buffer_pool*
+HGPU_GPU_buffer_pool_new(void){
+    HGPU_GPU_buffer_pool* result = (HGPU_GPU_buffer_pool*) calloc(1,sizeof(HGPU_GPU_buffer_pool));
+    if (!result) HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for buffer pool");
+    return result;
+}
+
+// delete pool of buffers (release all pooled cl_mem objects and host memory)
+void
+HGPU_GPU_buffer_pool_delete(HGPU_GPU_buffer_pool** pool){
+    if ((!pool) || (!(*pool))) return;
+    for (unsigned int i=0; i<(*pool)->number_of_buffers; i++)   HGPU_GPU_buffer_mem_release((*pool)->buffer[i]);
+    for (unsigned int i=0; i<(*pool)->number_of_host_ptrs; i++) free((*pool)->host_ptr[i]);
+    free(*pool);
+    (*pool) = NULL;
+}
+
+// take cl_mem object of the same flags and size class from pool; returns NULL if there is no such object
+cl_mem
+HGPU_GPU_buffer_pool_get(HGPU_GPU_buffer_pool* pool,cl_mem_flags flags,size_t buffer_size_in_bytes){
+    cl_mem result = NULL;
+    if (!pool) return result;
+    size_t size_class = HGPU_GPU_buffer_pool_size_class(buffer_size_in_bytes);
+    unsigned int index = HGPU_GPU_MAX_POOLED_BUFFERS;
+    for (unsigned int i=0; i<pool->number_of_buffers; i++)
+        if ((pool->buffer_flags[i]==flags) && (pool->buffer_size[i]>=buffer_size_in_bytes) &&
+            (HGPU_GPU_buffer_pool_size_class(pool->buffer_size[i])==size_class) &&
+            ((index==HGPU_GPU_MAX_POOLED_BUFFERS) || (pool->buffer_size[i]<pool->buffer_size[index]))) index = i;
+    if (index==HGPU_GPU_MAX_POOLED_BUFFERS) {
+        pool->buffer_misses++;
+        return result;
+    }
+    result = pool->buffer[index];
+    pool->number_of_buffers--;
+    pool->buffer[index]       = pool->buffer[pool->number_of_buffers];
+    pool->buffer_flags[index] = pool->buffer_flags[pool->number_of_buffers];
+    pool->buffer_size[index]  = pool->buffer_size[pool->number_of_buffers];
+    pool->buffer_hits++;
+    return result;
+}
+
+// allocate zero-filled host memory (recycled from pool if there is memory of the same size class)
+void*
+HGPU_GPU_buffer_pool_host_alloc(HGPU_GPU_buffer_pool* pool,size_t size_in_bytes){
+    if ((!pool) || (!size_in_bytes)) return calloc(size_in_bytes,1);
+    size_t size_class = HGPU_GPU_buffer_pool_size_class(size_in_bytes);
+    unsigned int index = HGPU_GPU_MAX_POOLED_BUFFERS;
+    for (unsigned int i=0; i<pool->number_of_host_ptrs; i++)
+        if ((pool->host_size[i]>=size_in_bytes) && (HGPU_GPU_buffer_pool_size_class(pool->host_size[i])==size_class) &&
+            ((index==HGPU_GPU_MAX_POOLED_BUFFERS) || (pool->host_size[i]<pool->host_size[index]))) index = i;
+    if (index==HGPU_GPU_MAX_POOLED_BUFFERS) {
+        pool->host_misses++;
+        return calloc(size_in_bytes,1);
+    }
+    void* result = pool->host_ptr[index];
+    pool->number_of_host_ptrs--;
+    pool->host_ptr[index]  = pool->host_ptr[pool->number_of_host_ptrs];
+    pool->host_size[index] = pool->host_size[pool->number_of_host_ptrs];
+    pool->host_hits++;
+    memset(result,0,size_in_bytes);
+    return result;
+}
+
+// move cl_mem object of buffer to pool (buffer keeps it if pool is full);
+// zero-copy buffers and buffers, which are still mapped (e.g. after HGPU_GPU_buffer_map_async), are not recycled
+void
+HGPU_GPU_buffer_pool_put(HGPU_GPU_buffer_pool* pool,HGPU_GPU_buffer* buffer){
+    if ((!pool) || (!buffer) || (buffer->host_ptr) || (buffer->mapped_ptr)) return;
+    if ((buffer->buffer) && (pool->number_of_buffers<HGPU_GPU_MAX_POOLED_BUFFERS)) {
+        size_t buffer_size = 0;
+        HGPU_GPU_error_message(clGetMemObjectInfo(buffer->buffer,CL_MEM_SIZE,sizeof(buffer_size),&buffer_size,NULL),"clGetMemObjectInfo failed");
+        pool->buffer[pool->number_of_buffers]       = buffer->buffer;
+        pool->buffer_flags[pool->number_of_buffers] = HGPU_GPU_buffer_get_flags(buffer->buffer_type);
+        pool->buffer_size[pool->number_of_buffers]  = buffer_size;
+        pool->number_of_buffers++;
+        buffer->buffer = NULL;
+    }
+}
+
+// move host memory to pool (free it if there is no pool or pool is full)
+void
+HGPU_GPU_buffer_pool_host_free(HGPU_GPU_buffer_pool* pool,void* host_ptr,size_t size_in_bytes){
+    if (!host_ptr) return;
+    if ((!pool) || (!size_in_bytes) || (pool->number_of_host_ptrs>=HGPU_GPU_MAX_POOLED_BUFFERS)) {
+        free(host_ptr);
+        return;
+    }
+    pool->host_ptr[pool->number_of_host_ptrs]  = host_ptr;
+    pool->host_size[pool->number_of_host_ptrs] = size_in_bytes;
+    pool->number_of_host_ptrs++;
+}
+
+// print statistics of buffer pool
+void
+HGPU_GPU_buffer_pool_print(HGPU_GPU_buffer_pool* pool){
+    if (!pool) return;
+    printf("Buffer pool: device buffers %lld hits / %lld misses, host memory %lld hits / %lld misses\n",
+        pool->buffer_hits,pool->buffer_misses,pool->host_hits,pool->host_misses);
+}
+
 // wait for event
 void
 HGPU_GPU_buffer_wait_for_event(cl_event* buffer_event){
-    if (buffer_event) {
+    if ((buffer_event) && (*buffer_event)) {
         HGPU_GPU_error_message(clWaitForEvents(1, buffer_event),"clWaitForEvents failed");
     }
 }
@@ -57,20 +57,40 @@
 
            unsigned int   HGPU_GPU_buffer_init(HGPU_GPU_buffer*** buffers,cl_context context,void* host_ptr_to_buffer,
                                                HGPU_GPU_buffer_types buffer_type,size_t buffer_elements,size_t sizeof_element);
+           unsigned int   HGPU_GPU_buffer_init_pooled(HGPU_GPU_buffer*** buffers,cl_context context,cl_command_queue queue,HGPU_GPU_buffer_pool* pool,
+                                               void* host_ptr_to_buffer,HGPU_GPU_buffer_types buffer_type,size_t buffer_elements,size_t sizeof_element);
+           unsigned int   HGPU_GPU_buffer_init_zero_copy(HGPU_GPU_buffer*** buffers,cl_context context,HGPU_GPU_buffer_pool* pool,
+                                               void* host_ptr_to_buffer,HGPU_GPU_buffer_types buffer_type,size_t buffer_elements,size_t sizeof_element);
+           cl_mem_flags   HGPU_GPU_buffer_get_flags(HGPU_GPU_buffer_types buffer_type);
 
                    void   HGPU_GPU_buffer_set_name(HGPU_GPU_buffer* buffer,const char* buffer_name);
                    void*  HGPU_GPU_buffer_map(HGPU_GPU_buffer* buffer,cl_command_queue queue);
                    void*  HGPU_GPU_buffer_map_with_profiling(HGPU_GPU_buffer* buffer,cl_command_queue queue);
                    void*  HGPU_GPU_buffer_map_async(HGPU_GPU_buffer* buffer,cl_command_queue queue);
+                   void*  HGPU_GPU_buffer_map_async_wait_list(HGPU_GPU_buffer* buffer,cl_command_queue queue,cl_uint events_number,const cl_event* events);
+                   void*  HGPU_GPU_buffer_map_wait(HGPU_GPU_buffer* buffer);
+                   bool   HGPU_GPU_buffer_map_is_complete(HGPU_GPU_buffer* buffer);
                    void   HGPU_GPU_buffer_unmap(HGPU_GPU_buffer* buffer,cl_command_queue queue,void* data_ptr);
                    void   HGPU_GPU_buffer_unmap_with_profiling(HGPU_GPU_buffer* buffer,cl_command_queue queue,void* data_ptr);
                    void   HGPU_GPU_buffer_unmap_async(HGPU_GPU_buffer* buffer,cl_command_queue queue,void* data_ptr);
+                   void   HGPU_GPU_buffer_unmap_async_wait_list(HGPU_GPU_buffer* buffer,cl_command_queue queue,void* data_ptr,
+                                                                cl_uint events_number,const cl_event* events);
                    void   HGPU_GPU_buffer_profile_map(HGPU_GPU_buffer* buffer);
                    void   HGPU_GPU_buffer_profile_unmap(HGPU_GPU_buffer* buffer);
 
                  cl_mem   HGPU_GPU_buffer_create(cl_context context,cl_mem_flags flags,size_t buffer_size_in_bytes,void* host_ptr_to_buffer);
                    void   HGPU_GPU_buffer_mem_release(cl_mem buffer);
                  size_t   HGPU_GPU_buffer_size_align_step(size_t buffer_size,size_t step);
+                   void*  HGPU_GPU_buffer_host_alloc_aligned(size_t size_in_bytes);
+                   void   HGPU_GPU_buffer_host_free_aligned(void* host_ptr);
+
+   HGPU_GPU_buffer_pool*  HGPU_GPU_buffer_pool_new(void);
+                   void   HGPU_GPU_buffer_pool_delete(HGPU_GPU_buffer_pool** pool);
+                 cl_mem   HGPU_GPU_buffer_pool_get(HGPU_GPU_buffer_pool* pool,cl_mem_flags flags,size_t buffer_size_in_bytes);
+                   void*  HGPU_GPU_buffer_pool_host_alloc(HGPU_GPU_buffer_pool* pool,size_t size_in_bytes);
+                   void   HGPU_GPU_buffer_pool_put(HGPU_GPU_buffer_pool* pool,HGPU_GPU_buffer* buffer);
+                   void   HGPU_GPU_buffer_pool_host_free(HGPU_GPU_buffer_pool* pool,void* host_ptr,size_t size_in_bytes);
+                   void   HGPU_GPU_buffer_pool_print(HGPU_GPU_buffer_pool* pool);
                    void   HGPU_GPU_buffer_wait_for_event(cl_event* buffer_event);
 
 #endif
@@ -49,6 +49,12 @@
 #define HGPU_GPU_MAX_BUFFERS                1024
 #define HGPU_GPU_MAX_ARGUMENTS                16
 #define HGPU_GPU_MAX_TIMERS                   64
+#define HGPU_GPU_MAX_PENDING_EVENTS           64
+#define HGPU_GPU_MAX_POOLED_BUFFERS           32
+#define HGPU_GPU_ZERO_COPY_ALIGNMENT        4096
+#define HGPU_GPU_ZERO_COPY_SIZE_STEP          64
+#define HGPU_GPU_PROGRAM_CACHE_LOCK_TIMEOUT  600    // maximal time (in seconds) to wait for program compiled by another process
+#define HGPU_GPU_PROGRAM_CACHE_LOCK_POLL      50    // interval (in milliseconds) of checks for program compiled by another process
 //#define HGPU_GPU_MAX_STR_INFO_LENGHT        HGPU_MAX_STR_INFO_LENGHT
 //#define HGPU_GPU_MAX_FILE_READ_BUFFER       HGPU_MAX_FILE_READ_BUFFER
 #define HGPU_GPU_MAX_OPTIONS_LENGTH         8192
@@ -61,6 +67,8 @@
 #define HGPU_PRNG_TEST_MAX_DURATION         (3.0) // particular PRNG test duration (in seconds)
 #define HGPU_PRNG_TEST_MAX_PASSES         100000  // maximal numeber of passes in particular PRNG test
 #define HGPU_PRNG_DEFAULT_SAMPLES         204800  // default number of samples for PRNG
+#define HGPU_PRNG_TEST_TOLERANCE_SINGLE   (1.0e-5)  // GPU vs CPU tolerance for non-uniform distributions (single precision)
+#define HGPU_PRNG_TEST_TOLERANCE_DOUBLE   (1.0e-12) // GPU vs CPU tolerance for non-uniform distributions (double precision)
 
 #define HGPU_OPENCL_OPTION_ERROR               "-Werror"
 #define HGPU_OPENCL_OPTION_ERROR_SP            " -Werror"
@@ -38,6 +38,43 @@
 
 #include "hgpucl_context.h"
 
+// create command queue for device of context
+static cl_command_queue
+HGPU_GPU_context_queue_create(HGPU_GPU_context* context,bool out_of_order){
+    cl_int GPU_error = CL_SUCCESS;
+    cl_command_queue result = NULL;
+    cl_command_queue_properties properties = 0;
+    if (context->debug_flags.profiling) properties |= (CL_QUEUE_PROFILING_ENABLE); // enable profiling for debuging
+    if (out_of_order) properties |= (CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+#ifndef CL_VERSION_2_0   // check OpenCL 2.0 compatibility
+    // for OpenCL 1.0, 1.1 or 1.2
+    result = clCreateCommandQueue(context->context,context->device,properties,&GPU_error);
+#else
+    // for OpenCL 2.0
+    cl_queue_properties queue_properties[] = { CL_QUEUE_PROPERTIES, (cl_queue_properties) properties, 0 };
+    result = clCreateCommandQueueWithProperties(context->context,context->device,queue_properties,&GPU_error);
+#endif
+    HGPU_GPU_error_message(GPU_error,"clCreateCommandQueue failed");
+    return result;
+}
+
+// commands without wait list keep in-order semantics: they start after all commands enqueued before
+// (barrier is needed for out-of-order compute queue or after commands of separate transfer queue)
+static void
+HGPU_GPU_context_queue_order(HGPU_GPU_context* context){
+    if ((!context->debug_flags.out_of_order) && (!context->queue_transfer_event)) return;
+    cl_uint   events_number = (context->queue_transfer_event) ? 1 : 0;
+    cl_event* events        = (context->queue_transfer_event) ? &context->queue_transfer_event : NULL;
+#ifdef CL_VERSION_1_2
+    HGPU_GPU_error_message(clEnqueueBarrierWithWaitList(context->queue,events_number,events,NULL),"clEnqueueBarrierWithWaitList failed");
+#else
+    if (events_number) HGPU_GPU_error_message(clEnqueueWaitForEvents(context->queue,events_number,events),"clEnqueueWaitForEvents failed");
+    HGPU_GPU_error_message(clEnqueueBarrier(context->queue),"clEnqueueBarrier failed");
+#endif
+    if (context->queue_transfer_event) HGPU_GPU_error_message(clReleaseEvent(context->queue_transfer_event),"clReleaseEvent failed");
+    context->queue_transfer_event = NULL;
+}
+
 // create new context
 HGPU_GPU_context*
 HGPU_GPU_context_new(cl_device_id device,HGPU_GPU_debug debug_flags){
@@ -58,24 +95,23 @@ HGPU_GPU_context_new(cl_device_id device,HGPU_GPU_debug debug_flags){
     context->context     = clCreateContext(NULL,1,&device,NULL, NULL, &GPU_error);
     HGPU_GPU_error_message(GPU_error,"clCreateContext failed");
     context->program     = NULL;
+    context->program_entry = NULL;
+    context->number_of_program_entries = 0;
     context->kernel      = NULL;
     context->buffer      = NULL;
-
-#ifndef CL_VERSION_2_0   // check OpenCL 2.0 compatibility
-    // for OpenCL 1.0, 1.1 or 1.2
-    cl_command_queue_properties profiling_properties = 0;
-    if(context->debug_flags.profiling) profiling_properties |= (CL_QUEUE_PROFILING_ENABLE); // enable profiling for debuging
-    context->queue = clCreateCommandQueue(context->context,context->device,profiling_properties,&GPU_error);
-#else
-    // for OpenCL 2.0
-    cl_queue_properties profiling_properties[] = { CL_QUEUE_PROPERTIES, (context->debug_flags.profiling) ?
-        (cl_command_queue_properties) CL_QUEUE_PROFILING_ENABLE : 0, 0 }; // enable profiling for debuging
-    context->queue = clCreateCommandQueueWithProperties(context->context,context->device,profiling_properties,&GPU_error);
-#endif
-    HGPU_GPU_error_message(GPU_error,"clCreateCommandQueue failed");
-
-    if (context->debug_flags.rebuild_binaries)
-        HGPU_io_inf_file_delete_all();
+    context->buffer_pool = (debug_flags.no_buffer_pool) ? NULL : HGPU_GPU_buffer_pool_new();
+
+    if (context->debug_flags.out_of_order) {
+        cl_command_queue_properties device_properties = 0;
+        HGPU_GPU_error_message(clGetDeviceInfo(device,CL_DEVICE_QUEUE_PROPERTIES,sizeof(device_properties),&device_properties,NULL),"clGetDeviceInfo failed");
+        if (!(device_properties & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE)) {
+            HGPU_GPU_error_note(CL_INVALID_QUEUE_PROPERTIES,"out-of-order execution is not supported by device");
+            context->debug_flags.out_of_order = false;
+        }
+    }
+    context->queue = HGPU_GPU_context_queue_create(context,context->debug_flags.out_of_order);
+    context->queue_transfer = (context->debug_flags.transfer_queue) ? HGPU_GPU_context_queue_create(context,false) : context->queue;
+    context->queue_transfer_event = NULL;
 
     return context;
 }
@@ -84,11 +120,17 @@ HGPU_GPU_context_new(cl_device_id device,HGPU_GPU_debug debug_flags){
 void
 HGPU_GPU_context_delete(HGPU_GPU_context** context){
     bool flag = (*context)->debug_flags.wait_for_keypress;
+    if ((*context)->queue_transfer_event) clReleaseEvent((*context)->queue_transfer_event);
+    if (((*context)->queue_transfer) && ((*context)->queue_transfer!=(*context)->queue))
+        HGPU_GPU_error_message(clReleaseCommandQueue((*context)->queue_transfer),"clReleaseCommandQueue failed");
     if (!(*context)->queue)   HGPU_GPU_error_message(clReleaseCommandQueue((*context)->queue),"clReleaseCommandQueue failed");
     if (!(*context)->context) HGPU_GPU_error_message(clReleaseContext((*context)->context),"clReleaseContext failed");
     free((*context)->program);
+    HGPU_program_registry_delete(*context);
     HGPU_GPU_kernels_delete(&((*context)->kernel));
     HGPU_GPU_buffers_delete(&((*context)->buffer));
+    HGPU_GPU_buffer_pool_delete(&((*context)->buffer_pool));
+    HGPU_GPU_device_release((*context)->device);
     free(*context);
     (*context) = NULL;
 
@@ -143,6 +185,65 @@ HGPU_GPU_context_select_auto_next(HGPU_GPU_context* context,HGPU_parameter** par
     return result;
 }
 
+// create contexts for all OpenCL devices selected according to parameters (the best one first);
+// number of contexts could be limited by DEVICES_NUMBER parameter; returns NULL-terminated array of contexts;
+// with DEVICE_FISSION CPU device is partitioned into NUMA-local sub-devices with own context (queue and buffers) each
+HGPU_GPU_context**
+HGPU_GPU_contexts_select_auto(HGPU_parameter** parameters){
+    HGPU_parameters_path_setup(parameters);
+    HGPU_GPU_devices* devices = HGPU_GPU_devices_select_auto(parameters);
+    unsigned int number_of_devices = HGPU_GPU_devices_get_number(devices);
+    if (!number_of_devices) HGPU_GPU_error_message(HGPU_ERROR_NO_DEVICE,"there is no any desired OpenCL device");
+    HGPU_GPU_devices_sort(&devices);
+
+    HGPU_parameter* parameter_devices_number = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_DEVICES_NUMBER);
+    if (parameter_devices_number && (parameter_devices_number->value_integer))
+        number_of_devices = MIN(number_of_devices,(unsigned int) parameter_devices_number->value_integer);
+
+    HGPU_GPU_debug debug_flags = HGPU_GPU_debug_get_flags(parameters);
+    HGPU_GPU_devices** subdevices = (HGPU_GPU_devices**) calloc(number_of_devices,sizeof(HGPU_GPU_devices*));
+    if (!subdevices) HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for contexts");
+    unsigned int number_of_contexts = 0;
+    for (unsigned int i=0; i<number_of_devices; i++) {
+        if (debug_flags.device_fission) subdevices[i] = HGPU_GPU_device_partition_by_numa(devices->devices[i]);
+        number_of_contexts += (subdevices[i]) ? HGPU_GPU_devices_get_number(subdevices[i]) : 1;
+    }
+
+    HGPU_GPU_context** result = (HGPU_GPU_context**) calloc(number_of_contexts+1,sizeof(HGPU_GPU_context*));
+    if (!result) HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for contexts");
+    unsigned int context_index = 0;
+    for (unsigned int i=0; i<number_of_devices; i++) {
+        if (subdevices[i]) {
+            for (unsigned int j=0; j<HGPU_GPU_devices_get_number(subdevices[i]); j++)
+                result[context_index++] = HGPU_GPU_context_new(subdevices[i]->devices[j],debug_flags);
+            HGPU_GPU_devices_delete(&subdevices[i]);
+        } else
+            result[context_index++] = HGPU_GPU_context_new(devices->devices[i],debug_flags);
+    }
+    for (unsigned int i=0; i<number_of_contexts; i++) HGPU_GPU_context_check_flags(result[i]);
+    free(subdevices);
+    HGPU_GPU_devices_delete(&devices);
+    return result;
+}
+
+// get number of contexts in NULL-terminated array
+unsigned int
+HGPU_GPU_contexts_get_number(HGPU_GPU_context** contexts){
+    unsigned int result = 0;
+    if (!contexts) return result;
+    while (contexts[result]) result++;
+    return result;
+}
+
+// delete NULL-terminated array of contexts
+void
+HGPU_GPU_contexts_delete(HGPU_GPU_context*** contexts){
+    if ((!contexts) || (!(*contexts))) return;
+    for (unsigned int i=0; (*contexts)[i]; i++) HGPU_GPU_context_delete(&((*contexts)[i]));
+    free(*contexts);
+    (*contexts) = NULL;
+}
+
 // setup debug_flags with parameters
 HGPU_GPU_debug
 HGPU_GPU_debug_get_flags(HGPU_parameter** parameters){
@@ -156,6 +257,11 @@ HGPU_GPU_debug_get_flags(HGPU_parameter** parameters){
         HGPU_parameter* parameter_rebuid_binaries    = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_REBUILD_BINARIES);
         HGPU_parameter* parameter_warning_error      = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_WARNING_ERROR);
         HGPU_parameter* parameter_no_cache           = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_NO_CACHE);
+        HGPU_parameter* parameter_out_of_order       = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_OUT_OF_ORDER);
+        HGPU_parameter* parameter_transfer_queue     = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_TRANSFER_QUEUE);
+        HGPU_parameter* parameter_device_fission     = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_DEVICE_FISSION);
+        HGPU_parameter* parameter_no_buffer_pool     = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_NO_BUFFER_POOL);
+        HGPU_parameter* parameter_no_zero_copy       = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_NO_ZERO_COPY);
 
         if (parameter_max_workgroup_size) debug_flags.max_workgroup_size = parameter_max_workgroup_size->value_integer;
         if (parameter_wait_for_keypress)  debug_flags.wait_for_keypress  = true;
@@ -165,6 +271,11 @@ HGPU_GPU_debug_get_flags(HGPU_parameter** parameters){
         if (parameter_rebuid_binaries)    debug_flags.rebuild_binaries   = true;
         if (parameter_warning_error)      debug_flags.warning_error      = true;
         if (parameter_no_cache)           debug_flags.no_cache           = true;
+        if (parameter_out_of_order)       debug_flags.out_of_order       = true;
+        if (parameter_transfer_queue)     debug_flags.transfer_queue     = true;
+        if (parameter_device_fission)     debug_flags.device_fission     = true;
+        if (parameter_no_buffer_pool)     debug_flags.no_buffer_pool     = true;
+        if (parameter_no_zero_copy)       debug_flags.no_zero_copy       = true;
     }
     return debug_flags;
 }
@@ -192,7 +303,18 @@ HGPU_GPU_context_buffer_init(HGPU_GPU_context* context,void* host_ptr_to_buffer,
                              HGPU_GPU_buffer_types buffer_type,size_t buffer_elements,size_t sizeof_element){
     unsigned int result = HGPU_GPU_MAX_BUFFERS;
     if (!context) return result;
-    result = HGPU_GPU_buffer_init(&(context->buffer),context->context,host_ptr_to_buffer,buffer_type,buffer_elements,sizeof_element);
+    if ((context->device_info.host_unified_memory) && (!context->debug_flags.no_zero_copy) &&
+        ((buffer_type==HGPU_GPU_buffer_type_io) || (buffer_type==HGPU_GPU_buffer_type_device))) {
+        // buffers mapped by host are used in place on devices with unified memory
+        result = HGPU_GPU_buffer_init_zero_copy(&(context->buffer),context->context,context->buffer_pool,
+                                                host_ptr_to_buffer,buffer_type,buffer_elements,sizeof_element);
+    } else if (context->buffer_pool) {
+        // recycled buffer could be used by commands enqueued before
+        HGPU_GPU_context_queue_order(context);
+        result = HGPU_GPU_buffer_init_pooled(&(context->buffer),context->context,context->queue,context->buffer_pool,
+                                             host_ptr_to_buffer,buffer_type,buffer_elements,sizeof_element);
+    } else
+        result = HGPU_GPU_buffer_init(&(context->buffer),context->context,host_ptr_to_buffer,buffer_type,buffer_elements,sizeof_element);
 
     return result;
 }
@@ -205,15 +327,23 @@ HGPU_GPU_context_buffer_set_name(HGPU_GPU_context* context,unsigned int buffer_i
     HGPU_GPU_buffer_set_name(buffer,buffer_name);
 }
 
-// release buffer
+// release buffer (cl_mem object is moved to buffer pool for recycling)
 void
 HGPU_GPU_context_buffer_release(HGPU_GPU_context* context,unsigned int buffer_id){
     if (buffer_id<HGPU_GPU_MAX_BUFFERS) {
         HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_get_by_index(context->buffer,buffer_id);
+        HGPU_GPU_buffer_pool_put(context->buffer_pool,buffer);
         HGPU_GPU_buffer_release(buffer);
     }
 }
 
+// allocate zero-filled host memory for buffer (recycled from buffer pool, if possible)
+void*
+HGPU_GPU_context_buffer_host_alloc(HGPU_GPU_context* context,size_t buffer_elements,size_t sizeof_element){
+    HGPU_GPU_buffer_pool* pool = (context) ? context->buffer_pool : NULL;
+    return HGPU_GPU_buffer_pool_host_alloc(pool,buffer_elements*sizeof_element);
+}
+
 // buffer size align
 size_t
 HGPU_GPU_context_buffer_size_align(HGPU_GPU_context* context,size_t buffer_size){
@@ -282,12 +412,22 @@ HGPU_GPU_context_kernel_bind_constant_by_argument_id(HGPU_GPU_context* context,u
     return result;
 }
 
+// keep event of last command of separate transfer queue
+static void
+HGPU_GPU_context_queue_transfer_event_set(HGPU_GPU_context* context,cl_event transfer_event){
+    if ((context->queue_transfer==context->queue) || (!transfer_event)) return;
+    HGPU_GPU_error_message(clRetainEvent(transfer_event),"clRetainEvent failed");
+    if (context->queue_transfer_event) HGPU_GPU_error_message(clReleaseEvent(context->queue_transfer_event),"clReleaseEvent failed");
+    context->queue_transfer_event = transfer_event;
+}
+
 // run kernel
 void
 HGPU_GPU_context_kernel_run(HGPU_GPU_context* context,unsigned int kernel_id){
     if ((!context) || (kernel_id>=HGPU_GPU_MAX_KERNELS)) return;
     HGPU_GPU_kernel* kernel = HGPU_GPU_kernel_get_by_index(context->kernel,kernel_id);
     if (kernel) {
+        HGPU_GPU_context_queue_order(context);
         size_t max_wg_size = context->debug_flags.max_workgroup_size;
         if (max_wg_size) HGPU_GPU_kernel_limit_local_workgroup_size(kernel,context->device,max_wg_size);
         if (context->debug_flags.profiling)
@@ -305,10 +445,70 @@ HGPU_GPU_context_kernel_run_async(HGPU_GPU_context* context,unsigned int kernel_
     if (kernel) {
         size_t max_wg_size = context->debug_flags.max_workgroup_size;
         if (max_wg_size) HGPU_GPU_kernel_limit_local_workgroup_size(kernel,context->device,max_wg_size);
-        HGPU_GPU_kernel_run_async(kernel,context->queue);
+        HGPU_GPU_context_queue_order(context);
+        if (context->debug_flags.profiling)
+            HGPU_GPU_kernel_run_async_with_profiling(kernel,context->queue);
+        else
+            HGPU_GPU_kernel_run_async(kernel,context->queue);
+    }
+}
+
+// run kernel (asynchronous) in compute queue after events_number events of wait list only
+// (with OUT_OF_ORDER it may overlap with other commands, which are not in wait list)
+void
+HGPU_GPU_context_kernel_run_async_wait_list(HGPU_GPU_context* context,unsigned int kernel_id,cl_uint events_number,const cl_event* events){
+    if ((!context) || (kernel_id>=HGPU_GPU_MAX_KERNELS)) return;
+    HGPU_GPU_kernel* kernel = HGPU_GPU_kernel_get_by_index(context->kernel,kernel_id);
+    if (kernel) {
+        size_t max_wg_size = context->debug_flags.max_workgroup_size;
+        if (max_wg_size) HGPU_GPU_kernel_limit_local_workgroup_size(kernel,context->device,max_wg_size);
+        HGPU_GPU_kernel_run_async_wait_list(kernel,context->queue,events_number,events);
+        if (context->debug_flags.profiling) HGPU_GPU_kernel_retain_event(kernel);
     }
 }
 
+// check if last asynchronous kernel run is completed (without waiting)
+bool
+HGPU_GPU_context_kernel_is_complete(HGPU_GPU_context* context,unsigned int kernel_id){
+    bool result = false;
+    if ((!context) || (kernel_id>=HGPU_GPU_MAX_KERNELS)) return result;
+    HGPU_GPU_kernel* kernel = HGPU_GPU_kernel_get_by_index(context->kernel,kernel_id);
+    if (!kernel) return result;
+    if (!kernel->kernel_event) return true;
+    cl_int status = CL_COMPLETE;
+    HGPU_GPU_error_message(clGetEventInfo(kernel->kernel_event,CL_EVENT_COMMAND_EXECUTION_STATUS,sizeof(status),&status,NULL),"clGetEventInfo failed");
+    if (status<0) HGPU_GPU_error_message(status,"kernel run failed");
+    result = (status==CL_COMPLETE);
+    return result;
+}
+
+// get event of last kernel run (NULL if kernel was not run asynchronously)
+cl_event
+HGPU_GPU_context_kernel_get_event(HGPU_GPU_context* context,unsigned int kernel_id){
+    cl_event result = NULL;
+    if ((!context) || (kernel_id>=HGPU_GPU_MAX_KERNELS)) return result;
+    HGPU_GPU_kernel* kernel = HGPU_GPU_kernel_get_by_index(context->kernel,kernel_id);
+    if (kernel) result = kernel->kernel_event;
+    return result;
+}
+
+// run kernel number_of_runs times (asynchronous): runs are enqueued at once and submitted by single flush
+void
+HGPU_GPU_context_kernel_run_batch(HGPU_GPU_context* context,unsigned int kernel_id,unsigned int number_of_runs){
+    if ((!context) || (kernel_id>=HGPU_GPU_MAX_KERNELS) || (!number_of_runs)) return;
+    for (unsigned int i=0; i<number_of_runs; i++) HGPU_GPU_context_kernel_run_async(context,kernel_id);
+    HGPU_GPU_context_queue_flush(context);
+}
+
+// profile retained asynchronous runs of all kernels
+void
+HGPU_GPU_context_kernels_profile_pending(HGPU_GPU_context* context){
+    if (!context) return;
+    unsigned int number_of_kernels = HGPU_GPU_kernels_get_number(context->kernel);
+    for (unsigned int i=0; i<number_of_kernels; i++)
+        HGPU_GPU_kernel_profile_pending(HGPU_GPU_kernel_get_by_index(context->kernel,i));
+}
+
 // limit maximum workgroup size for kernel
 void
 HGPU_GPU_context_kernel_limit_max_workgroup_size(HGPU_GPU_context* context,unsigned int kernel_id){
@@ -360,6 +560,7 @@ HGPU_GPU_context_buffer_map(HGPU_GPU_context* context,unsigned int buffer_id){
     void* result = NULL;
     if ((!context) || (buffer_id>=HGPU_GPU_MAX_BUFFERS)) return result;
     HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_get_by_index(context->buffer,buffer_id);
+    HGPU_GPU_context_queue_order(context);
     if (context->debug_flags.profiling)
         result = HGPU_GPU_buffer_map_with_profiling(buffer,context->queue);
     else
@@ -373,9 +574,10 @@ HGPU_GPU_context_buffer_get_mapped(HGPU_GPU_context* context,unsigned int buffer
     void* result = NULL;
     if ((!context) || (buffer_id>=HGPU_GPU_MAX_BUFFERS)) return result;
     HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_get_by_index(context->buffer,buffer_id);
-    if (buffer)
-        if (!buffer->mapped_ptr) result = HGPU_GPU_context_buffer_map(context,buffer_id);
-        result = buffer->mapped_ptr;
+    if (buffer) {
+        if (!buffer->mapped_ptr) HGPU_GPU_context_buffer_map(context,buffer_id);
+        result = HGPU_GPU_buffer_map_wait(buffer); // buffer could be mapped asynchronously
+    }
     return result;
 
 }
@@ -386,15 +588,48 @@ HGPU_GPU_context_buffer_map_async(HGPU_GPU_context* context,unsigned int buffer_
     void* result = NULL;
     if ((!context) || (buffer_id>=HGPU_GPU_MAX_BUFFERS)) return result;
     HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_get_by_index(context->buffer,buffer_id);
+    HGPU_GPU_context_queue_order(context);
     result = HGPU_GPU_buffer_map_async(buffer,context->queue);
     return result;
 }
 
+// buffer map (asynchronous) in transfer queue after events_number events of wait list only
+void*
+HGPU_GPU_context_buffer_map_async_wait_list(HGPU_GPU_context* context,unsigned int buffer_id,cl_uint events_number,const cl_event* events){
+    void* result = NULL;
+    if ((!context) || (buffer_id>=HGPU_GPU_MAX_BUFFERS)) return result;
+    HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_get_by_index(context->buffer,buffer_id);
+    result = HGPU_GPU_buffer_map_async_wait_list(buffer,context->queue_transfer,events_number,events);
+    if (buffer) HGPU_GPU_context_queue_transfer_event_set(context,buffer->buffer_read_event);
+    return result;
+}
+
+// wait for asynchronous buffer map and return mapped pointer
+void*
+HGPU_GPU_context_buffer_map_wait(HGPU_GPU_context* context,unsigned int buffer_id){
+    void* result = NULL;
+    if ((!context) || (buffer_id>=HGPU_GPU_MAX_BUFFERS)) return result;
+    HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_get_by_index(context->buffer,buffer_id);
+    result = HGPU_GPU_buffer_map_wait(buffer);
+    return result;
+}
+
+// check if asynchronous buffer map is completed
+bool
+HGPU_GPU_context_buffer_map_is_complete(HGPU_GPU_context* context,unsigned int buffer_id){
+    bool result = false;
+    if ((!context) || (buffer_id>=HGPU_GPU_MAX_BUFFERS)) return result;
+    HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_get_by_index(context->buffer,buffer_id);
+    result = HGPU_GPU_buffer_map_is_complete(buffer);
+    return result;
+}
+
 // buffer unmap
 void
 HGPU_GPU_context_buffer_unmap(HGPU_GPU_context* context,unsigned int buffer_id,void* data_ptr){
     if ((!context) || (buffer_id>=HGPU_GPU_MAX_BUFFERS)) return;
     HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_get_by_index(context->buffer,buffer_id);
+    HGPU_GPU_context_queue_order(context);
     if (context->debug_flags.profiling)
         HGPU_GPU_buffer_unmap_with_profiling(buffer,context->queue,data_ptr);
     else
@@ -406,9 +641,38 @@ void
 HGPU_GPU_context_buffer_unmap_async(HGPU_GPU_context* context,unsigned int buffer_id,void* data_ptr){
     if ((!context) || (buffer_id>=HGPU_GPU_MAX_BUFFERS)) return;
     HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_get_by_index(context->buffer,buffer_id);
+    HGPU_GPU_context_queue_order(context);
     HGPU_GPU_buffer_unmap_async(buffer,context->queue,data_ptr);
 }
 
+// buffer unmap (asynchronous) in transfer queue after events_number events of wait list only
+void
+HGPU_GPU_context_buffer_unmap_async_wait_list(HGPU_GPU_context* context,unsigned int buffer_id,void* data_ptr,cl_uint events_number,const cl_event* events){
+    if ((!context) || (buffer_id>=HGPU_GPU_MAX_BUFFERS)) return;
+    HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_get_by_index(context->buffer,buffer_id);
+    HGPU_GPU_buffer_unmap_async_wait_list(buffer,context->queue_transfer,data_ptr,events_number,events);
+    if (buffer) HGPU_GPU_context_queue_transfer_event_set(context,buffer->buffer_write_event);
+}
+
+// get event of last buffer map (read) and unmap (write)
+cl_event
+HGPU_GPU_context_buffer_get_read_event(HGPU_GPU_context* context,unsigned int buffer_id){
+    cl_event result = NULL;
+    if ((!context) || (buffer_id>=HGPU_GPU_MAX_BUFFERS)) return result;
+    HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_get_by_index(context->buffer,buffer_id);
+    if (buffer) result = buffer->buffer_read_event;
+    return result;
+}
+
+cl_event
+HGPU_GPU_context_buffer_get_write_event(HGPU_GPU_context* context,unsigned int buffer_id){
+    cl_event result = NULL;
+    if ((!context) || (buffer_id>=HGPU_GPU_MAX_BUFFERS)) return result;
+    HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_get_by_index(context->buffer,buffer_id);
+    if (buffer) result = buffer->buffer_write_event;
+    return result;
+}
+
 // buffer - get memory object
 cl_mem
 HGPU_GPU_context_buffer_get(HGPU_GPU_context* context,unsigned int buffer_id){
@@ -445,6 +709,7 @@ HGPU_GPU_context_print_detailed_report(HGPU_GPU_context* context){
     HGPU_timer_deviation elapsed_time       = HGPU_timer_deviation_default;
     HGPU_timer_deviation elapsed_time_read  = HGPU_timer_deviation_default;
     HGPU_timer_deviation elapsed_time_write = HGPU_timer_deviation_default;
+    HGPU_GPU_context_kernels_profile_pending(context);
     printf("--------------------------------------------------------\n");
     unsigned int number_of_kernels = HGPU_GPU_kernels_get_number(context->kernel);
     for(unsigned int i=0;i<number_of_kernels;i++){
@@ -490,6 +755,7 @@ HGPU_GPU_context_print_detailed_report(HGPU_GPU_context* context){
             }
         }
     }
+    HGPU_GPU_buffer_pool_print(context->buffer_pool);
     printf("--------------------------------------------------------\n");
 }
 
@@ -510,7 +776,18 @@ HGPU_GPU_context_print_used_hardware(HGPU_GPU_context* context){
 // wait for queue finish
 void
 HGPU_GPU_context_queue_wait_for_finish(HGPU_GPU_context* context){
+    if (context->queue_transfer!=context->queue) HGPU_GPU_error_message(clFinish(context->queue_transfer),"clFinish failed");
     HGPU_GPU_error_message(clFinish(context->queue),"clFinish failed");
+    if (context->queue_transfer_event) HGPU_GPU_error_message(clReleaseEvent(context->queue_transfer_event),"clReleaseEvent failed");
+    context->queue_transfer_event = NULL;
+    if (context->debug_flags.profiling) HGPU_GPU_context_kernels_profile_pending(context);
+}
+
+// flush queue (start execution of enqueued commands without waiting)
+void
+HGPU_GPU_context_queue_flush(HGPU_GPU_context* context){
+    HGPU_GPU_error_message(clFlush(context->queue),"clFlush failed");
+    if (context->queue_transfer!=context->queue) HGPU_GPU_error_message(clFlush(context->queue_transfer),"clFlush failed");
 }
 
 // wait for event
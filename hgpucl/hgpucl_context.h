@@ -41,7 +41,7 @@
 
 #include "hgpucl.h"
 
-    const HGPU_GPU_debug HGPU_GPU_debug_default = { 0, false, false, false, false, false, false, false, false };
+    const HGPU_GPU_debug HGPU_GPU_debug_default = { 0, false, false, false, false, false, false, false, false, false, false, false, false, false };
 
        HGPU_GPU_context*  HGPU_GPU_context_new(cl_device_id device,HGPU_GPU_debug debug_flags);
                    void   HGPU_GPU_context_delete(HGPU_GPU_context** context);
@@ -51,6 +51,9 @@
        HGPU_GPU_context*  HGPU_GPU_context_autoselect_next(HGPU_GPU_context* context);
        HGPU_GPU_context*  HGPU_GPU_context_select_auto(HGPU_parameter** parameters);
        HGPU_GPU_context*  HGPU_GPU_context_select_auto_next(HGPU_GPU_context* context,HGPU_parameter** parameters);
+      HGPU_GPU_context**  HGPU_GPU_contexts_select_auto(HGPU_parameter** parameters);
+           unsigned int   HGPU_GPU_contexts_get_number(HGPU_GPU_context** contexts);
+                   void   HGPU_GPU_contexts_delete(HGPU_GPU_context*** contexts);
 
          HGPU_GPU_debug   HGPU_GPU_debug_get_flags(HGPU_parameter** parameters);
                    void   HGPU_GPU_context_check_flags(HGPU_GPU_context* context);
@@ -61,12 +64,21 @@
            unsigned int   HGPU_GPU_context_buffer_init(HGPU_GPU_context* context,void* host_ptr_to_buffer,
                                         HGPU_GPU_buffer_types buffer_type,size_t buffer_elements,size_t sizeof_element);
                    void   HGPU_GPU_context_buffer_release(HGPU_GPU_context* context,unsigned int buffer_index);
+                   void*  HGPU_GPU_context_buffer_host_alloc(HGPU_GPU_context* context,size_t buffer_elements,size_t sizeof_element);
                  size_t   HGPU_GPU_context_buffer_size_align(HGPU_GPU_context* context,size_t buffer_size);
                    void   HGPU_GPU_context_buffer_set_name(HGPU_GPU_context* context,unsigned int buffer_index,const char* buffer_name);
                    void*  HGPU_GPU_context_buffer_map(HGPU_GPU_context* context,unsigned int buffer_id);
                    void   HGPU_GPU_context_buffer_unmap(HGPU_GPU_context* context,unsigned int buffer_id,void* data_ptr);
                    void*  HGPU_GPU_context_buffer_map_async(HGPU_GPU_context* context,unsigned int buffer_id);
+                   void*  HGPU_GPU_context_buffer_map_async_wait_list(HGPU_GPU_context* context,unsigned int buffer_id,
+                                        cl_uint events_number,const cl_event* events);
+                   void*  HGPU_GPU_context_buffer_map_wait(HGPU_GPU_context* context,unsigned int buffer_id);
+                   bool   HGPU_GPU_context_buffer_map_is_complete(HGPU_GPU_context* context,unsigned int buffer_id);
                    void   HGPU_GPU_context_buffer_unmap_async(HGPU_GPU_context* context,unsigned int buffer_id,void* data_ptr);
+                   void   HGPU_GPU_context_buffer_unmap_async_wait_list(HGPU_GPU_context* context,unsigned int buffer_id,void* data_ptr,
+                                        cl_uint events_number,const cl_event* events);
+               cl_event   HGPU_GPU_context_buffer_get_read_event(HGPU_GPU_context* context,unsigned int buffer_id);
+               cl_event   HGPU_GPU_context_buffer_get_write_event(HGPU_GPU_context* context,unsigned int buffer_id);
                  cl_mem   HGPU_GPU_context_buffer_get(HGPU_GPU_context* context,unsigned int buffer_id);
                    void*  HGPU_GPU_context_buffer_get_mapped(HGPU_GPU_context* context,unsigned int buffer_id);
 
@@ -78,6 +90,12 @@
                                         size_t sizeof_constant,unsigned int argument_id);
                    void   HGPU_GPU_context_kernel_run(HGPU_GPU_context* context,unsigned int kernel_id);
                    void   HGPU_GPU_context_kernel_run_async(HGPU_GPU_context* context,unsigned int kernel_id);
+                   void   HGPU_GPU_context_kernel_run_async_wait_list(HGPU_GPU_context* context,unsigned int kernel_id,
+                                        cl_uint events_number,const cl_event* events);
+               cl_event   HGPU_GPU_context_kernel_get_event(HGPU_GPU_context* context,unsigned int kernel_id);
+                   bool   HGPU_GPU_context_kernel_is_complete(HGPU_GPU_context* context,unsigned int kernel_id);
+                   void   HGPU_GPU_context_kernel_run_batch(HGPU_GPU_context* context,unsigned int kernel_id,unsigned int number_of_runs);
+                   void   HGPU_GPU_context_kernels_profile_pending(HGPU_GPU_context* context);
                    void   HGPU_GPU_context_kernel_limit_max_workgroup_size(HGPU_GPU_context* context,unsigned int kernel_id);
                    char*  HGPU_GPU_context_kernel_get_name(HGPU_GPU_context* context,unsigned int kernel_id);
            unsigned int   HGPU_GPU_context_kernel_get_args_number(HGPU_GPU_context* context,unsigned int kernel_id);
@@ -90,6 +108,7 @@
                    void   HGPU_GPU_context_print_used_hardware(HGPU_GPU_context* context);
 
                    void   HGPU_GPU_context_queue_wait_for_finish(HGPU_GPU_context* context);
+                   void   HGPU_GPU_context_queue_flush(HGPU_GPU_context* context);
                    void   HGPU_GPU_context_event_wait_for(cl_event* context_event);
 
 #endif
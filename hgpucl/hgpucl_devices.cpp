@@ -628,6 +628,45 @@ HGPU_GPU_device_check_double_precision(cl_device_id device){
     return result;
 }
 
+// check if device shares physical memory with host (CL_DEVICE_HOST_UNIFIED_MEMORY or CPU device)
+bool
+HGPU_GPU_device_check_host_unified_memory(cl_device_id device){
+    cl_device_type device_type = 0;
+    HGPU_GPU_error_message(clGetDeviceInfo(device,CL_DEVICE_TYPE,sizeof(device_type),&device_type,NULL),"clGetDeviceInfo failed");
+    if (device_type & CL_DEVICE_TYPE_CPU) return true;
+    cl_bool host_unified_memory = CL_FALSE;
+    cl_int GPU_error = clGetDeviceInfo(device,CL_DEVICE_HOST_UNIFIED_MEMORY,sizeof(host_unified_memory),&host_unified_memory,NULL);
+    return ((GPU_error==CL_SUCCESS) && (host_unified_memory));
+}
+
+// partition CPU device into sub-devices, one per NUMA node (OpenCL 1.2);
+// returns NULL if device is not CPU, partitioning is not supported or there is only one NUMA node
+HGPU_GPU_devices*
+HGPU_GPU_device_partition_by_numa(cl_device_id device){
+    HGPU_GPU_devices* result = NULL;
+#ifdef CL_VERSION_1_2
+    cl_device_type device_type = 0;
+    HGPU_GPU_error_message(clGetDeviceInfo(device,CL_DEVICE_TYPE,sizeof(device_type),&device_type,NULL),"clGetDeviceInfo failed");
+    if (!(device_type & CL_DEVICE_TYPE_CPU)) return result;
+
+    const cl_device_partition_property properties[] = {CL_DEVICE_PARTITION_BY_AFFINITY_DOMAIN,CL_DEVICE_AFFINITY_DOMAIN_NUMA,0};
+    cl_uint number_of_subdevices = 0;
+    cl_int GPU_error = clCreateSubDevices(device,properties,0,NULL,&number_of_subdevices);
+    if ((GPU_error!=CL_SUCCESS) || (number_of_subdevices<2) || (number_of_subdevices>HGPU_GPU_MAX_DEVICES)) return result;
+    result = HGPU_GPU_devices_new(number_of_subdevices);
+    HGPU_GPU_error_message(clCreateSubDevices(device,properties,number_of_subdevices,result->devices,NULL),"clCreateSubDevices failed");
+#endif
+    return result;
+}
+
+// release device (sub-devices are released, release of root device has no effect)
+void
+HGPU_GPU_device_release(cl_device_id device){
+#ifdef CL_VERSION_1_2
+    if (device) HGPU_GPU_error_message(clReleaseDevice(device),"clReleaseDevice failed");
+#endif
+}
+
 // automatically select OpenCL devices according to (HGPU_parameter) parameters
 HGPU_GPU_devices*
 HGPU_GPU_devices_select_auto(HGPU_parameter** parameters){
@@ -809,6 +848,7 @@ HGPU_GPU_device_get_info(cl_device_id device){
         result.max_memory_width   = (size_t) HGPU_GPU_device_get_info_uint(device,CL_DEVICE_IMAGE3D_MAX_WIDTH);
         result.max_workgroup_size = HGPU_GPU_device_get_info_uint(device,CL_DEVICE_MAX_WORK_GROUP_SIZE);
         result.memory_align_factor= HGPU_GPU_device_get_info_uint(device,CL_DEVICE_MAX_WORK_GROUP_SIZE);
+        result.host_unified_memory= HGPU_GPU_device_check_host_unified_memory(device);
 
         if (result.max_memory_width)  result.max_memory_width  = HGPU_GPU_MAX_MEMORY_WIDTH;
         if (result.max_memory_height) result.max_memory_height = HGPU_GPU_MAX_MEMORY_HEIGHT;
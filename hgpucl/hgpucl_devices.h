@@ -104,6 +104,9 @@
            cl_device_id   HGPU_GPU_device_get_next(HGPU_GPU_devices* devices,cl_device_id device);
 
                    bool   HGPU_GPU_device_check_double_precision(cl_device_id device);
+                   bool   HGPU_GPU_device_check_host_unified_memory(cl_device_id device);
+       HGPU_GPU_devices*  HGPU_GPU_device_partition_by_numa(cl_device_id device);
+                   void   HGPU_GPU_device_release(cl_device_id device);
 
            cl_device_id   HGPU_GPU_device_select_auto(void);
            cl_device_id   HGPU_GPU_device_select_auto_next(cl_device_id device);
@@ -81,6 +81,7 @@ HGPU_GPU_kernel_new_empty(void){
         result->kernel_number_of_starts     = 0;
         result->kernel_elapsed_time         = 0.0;
         result->kernel_elapsed_time_squared = 0.0;
+        result->kernel_events_pending_number = 0;
     return result;
 }
 
@@ -88,6 +89,8 @@ HGPU_GPU_kernel_new_empty(void){
 void
 HGPU_GPU_kernel_delete(HGPU_GPU_kernel** kernel){
     if ((!kernel) || (!(*kernel))) return;
+    for (unsigned int i=0; i<(*kernel)->kernel_events_pending_number; i++) clReleaseEvent((*kernel)->kernel_events_pending[i]);
+    if ((*kernel)->kernel_event) clReleaseEvent((*kernel)->kernel_event);
     free((*kernel)->global_size);
     free((*kernel)->local_size);
     free(*kernel);
@@ -201,12 +204,11 @@ HGPU_GPU_kernel_get_local_worksize(HGPU_GPU_kernel* kernel,cl_device_id device){
 
 
 
-// run kernel
+// run kernel (in-order queue: all previously enqueued commands are finished with the kernel)
 void
 HGPU_GPU_kernel_run(HGPU_GPU_kernel* kernel,cl_command_queue queue){
     HGPU_GPU_kernel_run_async(kernel,queue);
-    HGPU_GPU_kernel_run_wait_for_finish(&kernel->kernel_event);
-    HGPU_GPU_kernel_run_wait_for_queue_finish(queue);
+    if (kernel) HGPU_GPU_kernel_run_wait_for_finish(&kernel->kernel_event);
 }
 
 
@@ -216,6 +218,7 @@ HGPU_GPU_kernel_run_with_profiling(HGPU_GPU_kernel* kernel,cl_command_queue queu
 	HGPU_GPU_kernel_run(kernel,queue);
     HGPU_GPU_kernel_run_profile(kernel);
     HGPU_GPU_error_message(clReleaseEvent(kernel->kernel_event),"clReleaseEvent failed");
+    kernel->kernel_event = NULL;
 }
 
 // run kernel without profiling
@@ -223,6 +226,7 @@ void
 HGPU_GPU_kernel_run_without_profiling(HGPU_GPU_kernel* kernel,cl_command_queue queue){
 	HGPU_GPU_kernel_run(kernel,queue);
     HGPU_GPU_error_message(clReleaseEvent(kernel->kernel_event),"clReleaseEvent failed");
+    kernel->kernel_event = NULL;
 }
 
 
@@ -230,30 +234,71 @@ HGPU_GPU_kernel_run_without_profiling(HGPU_GPU_kernel* kernel,cl_command_queue q
 // run kernel (asynchronous)
 void
 HGPU_GPU_kernel_run_async(HGPU_GPU_kernel* kernel,cl_command_queue queue){
+    HGPU_GPU_kernel_run_async_wait_list(kernel,queue,0,NULL);
+}
+
+// run kernel (asynchronous) after events_number events of wait list
+void
+HGPU_GPU_kernel_run_async_wait_list(HGPU_GPU_kernel* kernel,cl_command_queue queue,cl_uint events_number,const cl_event* events){
     if (!kernel){
         HGPU_GPU_error_note(HGPU_ERROR_BAD_KERNEL,"Trying to use null-kernel!");
         return;
     }
-    cl_event kernel_event = HGPU_GPU_kernel_start(kernel->kernel,queue,kernel->work_dimensions,kernel->global_size,kernel->local_size);
+    cl_event kernel_event = HGPU_GPU_kernel_start(kernel->kernel,queue,kernel->work_dimensions,kernel->global_size,kernel->local_size,
+                                                  events_number,events);
+    if (kernel->kernel_event) HGPU_GPU_error_message(clReleaseEvent(kernel->kernel_event),"clReleaseEvent failed"); // event of previous asynchronous run
 	kernel->kernel_event  = kernel_event;
     kernel->kernel_number_of_starts++;
 }
 
+// run kernel (asynchronous) and retain its event for lazy profiling (see HGPU_GPU_kernel_profile_pending)
+void
+HGPU_GPU_kernel_run_async_with_profiling(HGPU_GPU_kernel* kernel,cl_command_queue queue){
+    HGPU_GPU_kernel_run_async(kernel,queue);
+    HGPU_GPU_kernel_retain_event(kernel);
+}
+
+// retain event of last asynchronous kernel run for lazy profiling
+void
+HGPU_GPU_kernel_retain_event(HGPU_GPU_kernel* kernel){
+    if ((!kernel) || (!kernel->kernel_event)) return;
+    if (kernel->kernel_events_pending_number>=HGPU_GPU_MAX_PENDING_EVENTS) HGPU_GPU_kernel_profile_pending(kernel);
+    HGPU_GPU_error_message(clRetainEvent(kernel->kernel_event),"clRetainEvent failed");
+    kernel->kernel_events_pending[kernel->kernel_events_pending_number++] = kernel->kernel_event;
+}
+
+// add execution time of finished kernel run to kernel profiling data
+static void
+HGPU_GPU_kernel_profile_event(HGPU_GPU_kernel* kernel,cl_event* kernel_event){
+    cl_ulong kernel_start  = 0;
+    cl_ulong kernel_finish = 0;
+    HGPU_GPU_kernel_run_wait_for_finish(kernel_event);
+    HGPU_GPU_error_message(clGetEventProfilingInfo(*kernel_event,CL_PROFILING_COMMAND_START,sizeof(cl_ulong),&kernel_start, NULL),"clGetEventProfilingInfo failed");
+    HGPU_GPU_error_message(clGetEventProfilingInfo(*kernel_event,CL_PROFILING_COMMAND_END,  sizeof(cl_ulong),&kernel_finish,NULL),"clGetEventProfilingInfo failed");
+    double elapsed_time = (double) (kernel_finish-kernel_start);
+        kernel->kernel_elapsed_time          += elapsed_time;
+        kernel->kernel_elapsed_time_squared  += elapsed_time * elapsed_time;
+        kernel->kernel_start                  = kernel_start;
+        kernel->kernel_finish                 = kernel_finish;
+}
+
 // profile kernel run
 void
 HGPU_GPU_kernel_run_profile(HGPU_GPU_kernel* kernel){
-    if ((kernel) && (kernel->kernel_event)){
-        cl_ulong kernel_start  = 0;
-        cl_ulong kernel_finish = 0;
-        HGPU_GPU_kernel_run_wait_for_finish(&kernel->kernel_event);
-        HGPU_GPU_error_message(clGetEventProfilingInfo(kernel->kernel_event,CL_PROFILING_COMMAND_START,sizeof(cl_ulong),&kernel_start, NULL),"clGetEventProfilingInfo failed");
-        HGPU_GPU_error_message(clGetEventProfilingInfo(kernel->kernel_event,CL_PROFILING_COMMAND_END,  sizeof(cl_ulong),&kernel_finish,NULL),"clGetEventProfilingInfo failed");
-        double elapsed_time = (double) (kernel_finish-kernel_start);
-            kernel->kernel_elapsed_time          += elapsed_time;
-            kernel->kernel_elapsed_time_squared  += elapsed_time * elapsed_time;
-            kernel->kernel_start                  = kernel_start;
-            kernel->kernel_finish                 = kernel_finish;
+    if ((kernel) && (kernel->kernel_event))
+        HGPU_GPU_kernel_profile_event(kernel,&kernel->kernel_event);
+}
+
+// profile retained asynchronous kernel runs (waits for them) and release their events
+void
+HGPU_GPU_kernel_profile_pending(HGPU_GPU_kernel* kernel){
+    if (!kernel) return;
+    for (unsigned int i=0; i<kernel->kernel_events_pending_number; i++) {
+        HGPU_GPU_kernel_profile_event(kernel,&kernel->kernel_events_pending[i]);
+        HGPU_GPU_error_message(clReleaseEvent(kernel->kernel_events_pending[i]),"clReleaseEvent failed");
+        kernel->kernel_events_pending[i] = NULL;
     }
+    kernel->kernel_events_pending_number = 0;
 }
 
 // simple functions_______________________________________________________________________________________________
@@ -278,28 +323,20 @@ HGPU_GPU_kernel_bind_argument(cl_kernel kernel,unsigned int argument_id,size_t a
 
 // simple run of kernel
 cl_event
-HGPU_GPU_kernel_start(cl_kernel kernel,cl_command_queue queue,unsigned int work_dimensions,const size_t* global_size,const size_t* local_size){
+HGPU_GPU_kernel_start(cl_kernel kernel,cl_command_queue queue,unsigned int work_dimensions,const size_t* global_size,const size_t* local_size,
+                      cl_uint events_number,const cl_event* events){
     cl_int GPU_error = CL_SUCCESS;
     cl_event kernel_event  = 0;
-    GPU_error = clEnqueueNDRangeKernel(queue,kernel,work_dimensions,NULL,global_size,local_size, 0, NULL, &kernel_event);
+    GPU_error = clEnqueueNDRangeKernel(queue,kernel,work_dimensions,NULL,global_size,local_size, events_number, events, &kernel_event);
         HGPU_GPU_error_message(GPU_error,"clEnqueueNDRangeKernel failed");
     return kernel_event;
 }
 
-// wait for kernel finishing
+// wait for kernel finishing (host thread is blocked by OpenCL runtime, no busy-waiting)
 void
 HGPU_GPU_kernel_run_wait_for_finish(cl_event* kernel_event){
-    if (kernel_event) {
-        cl_uint GPU_error = CL_SUCCESS;
-        cl_uint status = CL_RUNNING;
-        do
-            GPU_error = clGetEventInfo((*kernel_event),CL_EVENT_COMMAND_EXECUTION_STATUS,sizeof(cl_int),&status,NULL);
-        while ((GPU_error==CL_SUCCESS) && (status!=CL_COMPLETE) && (status!=CL_QUEUED));
-
-        HGPU_GPU_error_message(GPU_error,"clGetEventInfo failed");
-        GPU_error = clWaitForEvents(1, kernel_event);
-        if (GPU_error!=CL_SUCCESS)
-            HGPU_GPU_error_message(GPU_error,"clWaitForEvents failed");
+    if ((kernel_event) && (*kernel_event)) {
+        HGPU_GPU_error_message(clWaitForEvents(1, kernel_event),"clWaitForEvents failed");
     }
 }
 
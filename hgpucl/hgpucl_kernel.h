@@ -63,13 +63,17 @@
                    void   HGPU_GPU_kernel_run_with_profiling(HGPU_GPU_kernel* kernel,cl_command_queue queue);
                    void   HGPU_GPU_kernel_run_without_profiling(HGPU_GPU_kernel* kernel,cl_command_queue queue);
                    void   HGPU_GPU_kernel_run_async(HGPU_GPU_kernel* kernel,cl_command_queue queue);
+                   void   HGPU_GPU_kernel_run_async_wait_list(HGPU_GPU_kernel* kernel,cl_command_queue queue,cl_uint events_number,const cl_event* events);
+                   void   HGPU_GPU_kernel_run_async_with_profiling(HGPU_GPU_kernel* kernel,cl_command_queue queue);
+                   void   HGPU_GPU_kernel_retain_event(HGPU_GPU_kernel* kernel);
                    void   HGPU_GPU_kernel_run_profile(HGPU_GPU_kernel* kernel);
+                   void   HGPU_GPU_kernel_profile_pending(HGPU_GPU_kernel* kernel);
 
 
               cl_kernel   HGPU_GPU_kernel_create(cl_program program,const char* kernel_name);
                    void   HGPU_GPU_kernel_bind_argument(cl_kernel kernel,unsigned int argument_id,size_t argument_size,const void* argument_ptr);
                cl_event   HGPU_GPU_kernel_start(cl_kernel kernel,cl_command_queue queue,unsigned int work_dimensions,
-                                                const size_t* global_size,const size_t* local_size);
+                                                const size_t* global_size,const size_t* local_size,cl_uint events_number,const cl_event* events);
                    void   HGPU_GPU_kernel_run_wait_for_finish(cl_event* kernel_event);
                    void   HGPU_GPU_kernel_run_wait_for_queue_finish(cl_command_queue queue);
 
@@ -38,6 +38,13 @@
 
 #include "hgpucl_program.h"
 
+// locks of program cache held by this process (released at exit, e.g. after build error)
+static             char** HGPU_program_cache_locks = NULL;
+static     unsigned int   HGPU_program_cache_locks_number = 0;
+static       std::mutex   HGPU_program_cache_locks_mutex;
+
+static void HGPU_program_cache_locks_release_all(void);
+
 cl_program
 HGPU_GPU_program_new(const char* source,HGPU_GPU_context* context){
     return HGPU_GPU_program_with_options_new(source,NULL,context);
@@ -45,128 +52,320 @@ HGPU_GPU_program_new(const char* source,HGPU_GPU_context* context){
 
 cl_program
 HGPU_GPU_program_with_options_new(const char* source,const char* options,HGPU_GPU_context* context){
+    // program with the same source and options is already built in context
+    cl_program program = HGPU_GPU_program_get_registered(context,source,options);
+    if (program) return program;
+
     HGPU_timer timer = HGPU_timer_start();
 // if no_cache - turn off environmental variable for CUDA (CUDA_CACHE_DISABLE=1)
 #ifdef _WIN32
     if (context->debug_flags.no_cache) _putenv_s("CUDA_CACHE_DISABLE","1"); // available in Windows only
 #endif
-    cl_int GPU_error = CL_SUCCESS;
-    cl_program program = 0;
     unsigned int program_number = context->number_of_programs + 1;
-    HGPU_parameter** parameters = NULL;
-    char* device_name = HGPU_GPU_device_get_name(context->device);
-        HGPU_parameter* parameter_device = HGPU_parameter_get_with_name_text((char*) HGPU_PARAMETER_INF_DEVICE,device_name);
-        free(device_name);
-    char* md5 = HGPU_md5(source);
-        HGPU_parameter* parameter_md5 = HGPU_parameter_get_with_name_text((char*) HGPU_PARAMETER_INF_MD5,md5);
-        free(md5);
-    char* platform_name = HGPU_GPU_platform_get_name(HGPU_GPU_device_get_platform(context->device));
-        HGPU_parameter* parameter_platform = HGPU_parameter_get_with_name_text((char*) HGPU_PARAMETER_INF_PLATFORM,platform_name);
-        free(platform_name);
 
-    HGPU_parameter* parameter_number = HGPU_parameter_get_with_name_integer((char*) HGPU_PARAMETER_INF_NUMBER,program_number);
+    char* options_new = HGPU_program_get_options(context,options);
+    char* cache_key   = NULL;
+    HGPU_parameter** parameters = HGPU_program_get_cache_parameters(context,source,options_new,&cache_key);
 
-    char* options_new = HGPU_string_clone(options);
-    if (context->debug_flags.warning_error){
-        if ((!options_new) || (options_new && (!strstr(options_new,HGPU_OPENCL_OPTION_ERROR))))
-            HGPU_string_join(&options_new,(char*) HGPU_OPENCL_OPTION_ERROR_SP);
+    // load binary from program cache (cached binary is rebuilt if it could not be loaded);
+    // concurrent processes compile program once: the one, which holds lock of cache entry, compiles, others wait for its binary
+    bool cache_locked = false;
+    if (!context->debug_flags.no_cache) {
+        if (!context->debug_flags.rebuild_binaries)
+            program = HGPU_program_build_from_cache(context,cache_key,options_new);
+        if (!program) {
+            cache_locked = HGPU_program_cache_lock(cache_key);
+            if ((!cache_locked) || (!context->debug_flags.rebuild_binaries))
+                program = HGPU_program_build_from_cache(context,cache_key,options_new);
+        }
     }
 
-    HGPU_parameter* parameter_options = HGPU_parameter_get_with_name_text((char*) HGPU_PARAMETER_INF_OPTIONS,options);
+    if (!program) {
+        // compile file
+        printf("\nprogram%u.bin is compiling... \n",program_number);
+        program = HGPU_program_build_to_cache(context,source,options_new,parameters,cache_key);
+        printf("program%u.bin compilation done (%f seconds)!\n",program_number,HGPU_timer_get(timer));
+    }
 
-    HGPU_parameters_add(&parameters,parameter_platform);
-    HGPU_parameters_add(&parameters,parameter_device);
-    HGPU_parameters_add(&parameters,parameter_number);
-    HGPU_parameters_add(&parameters,parameter_options);
-    HGPU_parameter** parameters_without_md5 = HGPU_parameters_clone(parameters);
-    HGPU_parameters_add(&parameters,parameter_md5);
+    if (cache_locked) HGPU_program_cache_unlock(cache_key);
+    free(cache_key);
+    free(options_new);
+    HGPU_parameters_delete(&parameters);
+    HGPU_program_add(context,program);  // register program in context
+    HGPU_GPU_program_register(context,program,source,options);
+    return program;
+}
 
-    int GPU_inf_max_n = HGPU_io_inf_file_get_max_index();
+// get program built in context with source (or name of source file) and options (NULL if there is no such program)
+cl_program
+HGPU_GPU_program_get_registered(HGPU_GPU_context* context,const char* name,const char* options){
+    if ((!context) || (!name)) return NULL;
+    for (unsigned int i=0; i<context->number_of_program_entries; i++) {
+        HGPU_GPU_program_entry* entry = &context->program_entry[i];
+        if ((HGPU_program_key_equal(entry->options,options)) && (HGPU_program_key_equal(entry->name,name)))
+            return entry->program;
+    }
+    return NULL;
+}
 
-    int active_file = 0;
-    if (!context->debug_flags.no_cache) {
-        for (int i = 1; i <= GPU_inf_max_n; i++){
-            HGPU_parameter** inf_data = HGPU_parameters_get_from_inf_file(i);
-            if (HGPU_parameters_check(inf_data,parameters_without_md5)){
-                if (HGPU_parameters_check(inf_data,parameters)){
-                    // .inf-file found
-                    active_file = i;
-                    i = GPU_inf_max_n;
-                } else {
-                    // MD5 does not match
-                    // kill current .inf-file and rename last .inf-file into current
-                    HGPU_io_inf_file_delete(i);
-                    if (i<GPU_inf_max_n) HGPU_io_inf_file_rename(active_file,i);    // check if file is last
-                    GPU_inf_max_n--;
-                    i--;
+// register program in context under source (or name of source file) and options for reuse
+void
+HGPU_GPU_program_register(HGPU_GPU_context* context,cl_program program,const char* name,const char* options){
+    if ((!context) || (!program) || (!name) || (HGPU_GPU_program_get_registered(context,name,options))) return;
+    unsigned int number_of_entries = context->number_of_program_entries;
+    HGPU_GPU_program_entry* entries_new = (HGPU_GPU_program_entry*) realloc(context->program_entry,(number_of_entries+1)*sizeof(HGPU_GPU_program_entry));
+    if (!entries_new) HGPU_error(HGPU_ERROR_NO_MEMORY);
+    context->program_entry = entries_new;
+    context->program_entry[number_of_entries].program = program;
+    context->program_entry[number_of_entries].name    = HGPU_string_clone(name);
+    context->program_entry[number_of_entries].options = HGPU_string_clone(options);
+    context->number_of_program_entries++;
+}
+
+// delete registry of programs
+void
+HGPU_program_registry_delete(HGPU_GPU_context* context){
+    if (!context) return;
+    for (unsigned int i=0; i<context->number_of_program_entries; i++) {
+        free(context->program_entry[i].name);
+        free(context->program_entry[i].options);
+    }
+    free(context->program_entry);
+    context->program_entry = NULL;
+    context->number_of_program_entries = 0;
+}
+
+// compare keys of program registry (NULL options are equal to empty ones)
+bool
+HGPU_program_key_equal(const char* key1,const char* key2){
+    if (!key1) key1 = "";
+    if (!key2) key2 = "";
+    return (!strcmp(key1,key2));
+}
+
+// precompile programs (sources with corresponding options) into program cache in parallel by host threads;
+// programs, which are already cached, are skipped (this saves time of serial compilation on first use of programs)
+void
+HGPU_GPU_programs_precompile(HGPU_GPU_context* context,unsigned int number_of_programs,const char** sources,const char** options){
+    if ((!context) || (!number_of_programs) || (!sources) || (context->debug_flags.no_cache)) return;
+    HGPU_timer timer = HGPU_timer_start();
+    char**            options_new = (char**) calloc(number_of_programs,sizeof(char*));
+    char**            cache_keys  = (char**) calloc(number_of_programs,sizeof(char*));
+    HGPU_parameter*** parameters  = (HGPU_parameter***) calloc(number_of_programs,sizeof(HGPU_parameter**));
+    unsigned int*     jobs        = (unsigned int*) calloc(number_of_programs,sizeof(unsigned int));
+    if ((!options_new) || (!cache_keys) || (!parameters) || (!jobs)) HGPU_error(HGPU_ERROR_NO_MEMORY);
+
+    // cache keys are prepared serially (HGPU_md5 is not thread-safe)
+    unsigned int number_of_jobs = 0;
+    for (unsigned int i=0; i<number_of_programs; i++) {
+        options_new[i] = HGPU_program_get_options(context,(options) ? options[i] : NULL);
+        parameters[i]  = HGPU_program_get_cache_parameters(context,sources[i],options_new[i],&cache_keys[i]);
+        if ((context->debug_flags.rebuild_binaries) || (!HGPU_io_bin_file_check_existence(cache_keys[i])))
+            jobs[number_of_jobs++] = i;
+    }
+
+    if (number_of_jobs) {
+        printf("\n%u programs are compiling... \n",number_of_jobs);
+        unsigned int number_of_threads = MAX(1,MIN(number_of_jobs,std::thread::hardware_concurrency()));
+        std::atomic<unsigned int> next_job(0);
+        std::thread* threads = new std::thread[number_of_threads];
+        for (unsigned int t=0; t<number_of_threads; t++)
+            threads[t] = std::thread([&]() {
+                unsigned int job = next_job++;
+                while (job<number_of_jobs) {
+                    unsigned int i = jobs[job];
+                    if (HGPU_program_cache_lock(cache_keys[i])) {
+                        if ((context->debug_flags.rebuild_binaries) || (!HGPU_io_bin_file_check_existence(cache_keys[i]))) {
+                            cl_program program = HGPU_program_build_to_cache(context,sources[i],options_new[i],parameters[i],cache_keys[i]);
+                            HGPU_GPU_error_message(clReleaseProgram(program),"clReleaseProgram failed");
+                        }
+                        HGPU_program_cache_unlock(cache_keys[i]);
+                    }
+                    job = next_job++;
                 }
-            }
-            HGPU_parameters_delete(&inf_data);
-        }
+            });
+        for (unsigned int t=0; t<number_of_threads; t++) threads[t].join();
+        delete[] threads;
+        printf("%u programs compilation done (%f seconds)!\n",number_of_jobs,HGPU_timer_get(timer));
     }
 
-    if (active_file == 0) active_file = GPU_inf_max_n + 1;
+    for (unsigned int i=0; i<number_of_programs; i++) {
+        free(options_new[i]);
+        free(cache_keys[i]);
+        HGPU_parameters_delete(&parameters[i]);
+    }
+    free(options_new);
+    free(cache_keys);
+    free(parameters);
+    free(jobs);
+}
+
+// get build options for program (-Werror is added with WARNING_ERROR)
+char*
+HGPU_program_get_options(HGPU_GPU_context* context,const char* options){
+    char* result = HGPU_string_clone(options);
+    if (context->debug_flags.warning_error){
+        if ((!result) || (result && (!strstr(result,HGPU_OPENCL_OPTION_ERROR))))
+            HGPU_string_join(&result,(char*) HGPU_OPENCL_OPTION_ERROR_SP);
+    }
+    return result;
+}
 
+// get parameters of program for .inf-file and cache key of program
+HGPU_parameter**
+HGPU_program_get_cache_parameters(HGPU_GPU_context* context,const char* source,const char* options,char** cache_key){
+    HGPU_parameter** parameters = NULL;
+    char* platform_name = HGPU_GPU_platform_get_name(HGPU_GPU_device_get_platform(context->device));
+    char* device_name   = HGPU_GPU_device_get_name(context->device);
+    char* driver        = HGPU_GPU_device_get_info_str(context->device,CL_DRIVER_VERSION);
+    char* md5           = HGPU_md5(source);
+    char* current_date  = HGPU_timer_get_current_datetime();
+    (*cache_key) = HGPU_program_get_cache_key(platform_name,device_name,driver,options,md5);
 
-    char* current_date = HGPU_timer_get_current_datetime();
-        HGPU_parameter* parameter_date = HGPU_parameter_get_with_name_text((char*) HGPU_PARAMETER_INF_DATE,current_date);
-        free(current_date);
+        HGPU_parameter* parameter_platform = HGPU_parameter_get_with_name_text((char*) HGPU_PARAMETER_INF_PLATFORM,platform_name);
+        HGPU_parameter* parameter_device   = HGPU_parameter_get_with_name_text((char*) HGPU_PARAMETER_INF_DEVICE,device_name);
+        HGPU_parameter* parameter_driver   = HGPU_parameter_get_with_name_text((char*) HGPU_PARAMETER_INF_DRIVER,driver);
+        HGPU_parameter* parameter_options  = HGPU_parameter_get_with_name_text((char*) HGPU_PARAMETER_INF_OPTIONS,options);
+        HGPU_parameter* parameter_md5      = HGPU_parameter_get_with_name_text((char*) HGPU_PARAMETER_INF_MD5,md5);
+        HGPU_parameter* parameter_date     = HGPU_parameter_get_with_name_text((char*) HGPU_PARAMETER_INF_DATE,current_date);
+    HGPU_parameters_add(&parameters,parameter_platform);
+    HGPU_parameters_add(&parameters,parameter_device);
+    HGPU_parameters_add(&parameters,parameter_driver);
+    HGPU_parameters_add(&parameters,parameter_options);
+    HGPU_parameters_add(&parameters,parameter_md5);
     HGPU_parameters_add(&parameters,parameter_date);
         HGPU_parameter_delete(&parameter_date);
-        HGPU_parameter_delete(&parameter_options);
-        HGPU_parameter_delete(&parameter_number);
         HGPU_parameter_delete(&parameter_md5);
+        HGPU_parameter_delete(&parameter_options);
+        HGPU_parameter_delete(&parameter_driver);
         HGPU_parameter_delete(&parameter_device);
         HGPU_parameter_delete(&parameter_platform);
-        HGPU_parameters_delete(&parameters_without_md5);
+    free(current_date);
+    free(md5);
+    free(driver);
+    free(device_name);
+    free(platform_name);
+    return parameters;
+}
 
+// build program from source and save its binary into program cache (unless NO_CACHE)
+cl_program
+HGPU_program_build_to_cache(HGPU_GPU_context* context,const char* source,const char* options,HGPU_parameter** parameters,const char* cache_key){
+    cl_program result = HGPU_program_build(context->context,context->device,source,options);
+    char* buildlog = HGPU_program_get_buildlog(result,context->device);
+    if (buildlog) {
+        if (context->debug_flags.brief_report) printf("Program buid log: [%s]\n",buildlog);
+        if (context->debug_flags.warning_error) HGPU_error(HGPU_ERROR_WARNING_ERROR);
+        free(buildlog);
+    }
 
-    if ((active_file > GPU_inf_max_n) || (!HGPU_io_bin_file_check_existence(active_file))) {
-        // compile file
-        printf("\nprogram%u.bin is compiling... \n",program_number);
+    unsigned char* binary_code = NULL;
+    size_t binary_size = 0;
+    HGPU_program_get_binary(result,context->device,&binary_code,&binary_size);
+    if (!context->debug_flags.no_cache) HGPU_parameters_write_to_inf_file(parameters,binary_code,binary_size,cache_key); // save .inf and .bin files
+    free(binary_code);
+    return result;
+}
 
-        program = HGPU_program_build(context->context,context->device,source,options_new);
-        char* buildlog = HGPU_program_get_buildlog(program,context->device);
-        if (buildlog) {
-            if (context->debug_flags.brief_report) printf("Program buid log: [%s]\n",buildlog);
-            if (context->debug_flags.warning_error) HGPU_error(HGPU_ERROR_WARNING_ERROR);
-            free(buildlog);
+
+// get key of program cache: md5 of platform, device, driver version, build options and md5 of source
+char*
+HGPU_program_get_cache_key(const char* platform_name,const char* device_name,const char* driver,const char* options,const char* md5){
+    size_t key_source_length = strlen_s(platform_name) + strlen_s(device_name) + strlen_s(driver) + strlen_s(options) + strlen_s(md5) + 16;
+    char* key_source = (char*) calloc(key_source_length,sizeof(char));
+    if (!key_source) HGPU_error(HGPU_ERROR_NO_MEMORY);
+    sprintf_s(key_source,key_source_length,"%s\n%s\n%s\n%s\n%s",
+        (platform_name) ? platform_name : "",(device_name) ? device_name : "",(driver) ? driver : "",(options) ? options : "",(md5) ? md5 : "");
+    char* result = HGPU_md5(key_source);
+    free(key_source);
+    return result;
+}
+
+// lock program cache entry for compilation; if entry is locked by another process, wait until it is unlocked
+// (returns true if lock is acquired, false if another process has compiled program meanwhile);
+// lock is removed as stale if its owner on this host is not running anymore, or if lock file is older than
+// HGPU_GPU_PROGRAM_CACHE_LOCK_TIMEOUT and this process has waited for it as long (clocks of hosts could differ)
+bool
+HGPU_program_cache_lock(const char* cache_key){
+    HGPU_timer timer = HGPU_timer_start();
+    while (!HGPU_io_lock_file_acquire(cache_key)) {
+        while (HGPU_io_lock_file_check_existence(cache_key)) {
+            bool stale = (HGPU_io_lock_file_check_orphaned(cache_key)) ||
+                         ((HGPU_timer_get(timer)>HGPU_GPU_PROGRAM_CACHE_LOCK_TIMEOUT) &&
+                          (HGPU_io_lock_file_get_age(cache_key)>HGPU_GPU_PROGRAM_CACHE_LOCK_TIMEOUT));
+            if (stale) {
+                HGPU_io_lock_file_release(cache_key);
+                timer = HGPU_timer_start();     // the next owner of lock is waited for from the beginning
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(HGPU_GPU_PROGRAM_CACHE_LOCK_POLL));
         }
+        if (HGPU_io_bin_file_check_existence(cache_key)) return false;
+    }
 
-        unsigned char* binary_code = NULL;
-        size_t binary_size = 0;
-        HGPU_program_get_binary(program,context->device,&binary_code,&binary_size);
-        if (!context->debug_flags.no_cache) HGPU_parameters_write_to_inf_file(parameters,binary_code,binary_size,active_file); // save .inf and .bin files
+    std::lock_guard<std::mutex> guard(HGPU_program_cache_locks_mutex);
+    if (!HGPU_program_cache_locks) atexit(HGPU_program_cache_locks_release_all);
+    char** locks_new = (char**) realloc(HGPU_program_cache_locks,(HGPU_program_cache_locks_number+1)*sizeof(char*));
+    if (!locks_new) HGPU_error(HGPU_ERROR_NO_MEMORY);
+    HGPU_program_cache_locks = locks_new;
+    HGPU_program_cache_locks[HGPU_program_cache_locks_number++] = HGPU_string_clone(cache_key);
+    return true;
+}
 
-        printf("program%u.bin compilation done (%f seconds)!\n",program_number,HGPU_timer_get(timer));
+// unlock program cache entry locked by HGPU_program_cache_lock
+void
+HGPU_program_cache_unlock(const char* cache_key){
+    std::lock_guard<std::mutex> guard(HGPU_program_cache_locks_mutex);
+    for (unsigned int i=0; i<HGPU_program_cache_locks_number; i++) {
+        if (strcmp(HGPU_program_cache_locks[i],cache_key)) continue;
+        HGPU_io_lock_file_release(cache_key);
+        free(HGPU_program_cache_locks[i]);
+        HGPU_program_cache_locks[i] = HGPU_program_cache_locks[--HGPU_program_cache_locks_number];
+        break;
+    }
+}
 
-    } else {
-        // load binary file
-        size_t binary_size = 0;
-        unsigned char* binary = HGPU_io_bin_file_read(active_file,&binary_size);
+// release locks of program cache held by this process (at exit; exit could be called with locked mutex)
+static void
+HGPU_program_cache_locks_release_all(void){
+    std::unique_lock<std::mutex> guard(HGPU_program_cache_locks_mutex,std::try_to_lock);
+    for (unsigned int i=0; i<HGPU_program_cache_locks_number; i++) {
+        HGPU_io_lock_file_release(HGPU_program_cache_locks[i]);
+        free(HGPU_program_cache_locks[i]);
+    }
+    HGPU_program_cache_locks_number = 0;
+}
 
-        cl_int status;
-        program = clCreateProgramWithBinary(context->context,1,&context->device,&binary_size,(const unsigned char**) &binary,&status, &GPU_error);
-        HGPU_GPU_error_message(status,"clCreateProgramWithBinary failed");
-        HGPU_GPU_error_message(GPU_error,"clCreateProgramWithBinary failed");
+// build program from binary of program cache; returns NULL if there is no cached binary or it could not be built
+// (broken cached files are deleted)
+cl_program
+HGPU_program_build_from_cache(HGPU_GPU_context* context,const char* cache_key,const char* options){
+    cl_program result = NULL;
+    size_t binary_size = 0;
+    unsigned char* binary = HGPU_io_bin_file_read(cache_key,&binary_size);
+    if (!binary) return result;
 
-        HGPU_GPU_error_message(clBuildProgram(program,1,&context->device,options_new,NULL,NULL),"clBuildProgram failed");
-        char* buildlog = HGPU_program_get_buildlog(program,context->device);
+    cl_int status = CL_SUCCESS;
+    cl_int GPU_error = CL_SUCCESS;
+    result = clCreateProgramWithBinary(context->context,1,&context->device,&binary_size,(const unsigned char**) &binary,&status,&GPU_error);
+    if ((status==CL_SUCCESS) && (GPU_error==CL_SUCCESS))
+        GPU_error = clBuildProgram(result,1,&context->device,options,NULL,NULL);
+    if ((status!=CL_SUCCESS) || (GPU_error!=CL_SUCCESS)) {
+        HGPU_GPU_error_note(GPU_error,"cached program binary could not be built");
+        if (result) clReleaseProgram(result);
+        result = NULL;
+        HGPU_io_inf_file_delete(cache_key);
+    } else {
+        char* buildlog = HGPU_program_get_buildlog(result,context->device);
         if (buildlog) {
             if (context->debug_flags.brief_report) printf("Program buid log: [%s]\n",buildlog);
-            // exit, if warning = error
-
             free(buildlog);
         }
-        free(binary);
     }
-    
-    HGPU_parameters_delete(&parameters);
-    HGPU_program_add(context,program);  // register program in context
-    return program;
+    free(binary);
+    return result;
 }
 
-
 // add new program to the array of programs
 void
 HGPU_program_add(HGPU_GPU_context* context,cl_program program){
@@ -43,8 +43,22 @@
 
              cl_program   HGPU_GPU_program_new(const char* source,HGPU_GPU_context* context);
              cl_program   HGPU_GPU_program_with_options_new(const char* source,const char* options,HGPU_GPU_context* context);
+             cl_program   HGPU_GPU_program_get_registered(HGPU_GPU_context* context,const char* name,const char* options);
+                   void   HGPU_GPU_program_register(HGPU_GPU_context* context,cl_program program,const char* name,const char* options);
+                   void   HGPU_GPU_programs_precompile(HGPU_GPU_context* context,unsigned int number_of_programs,const char** sources,const char** options);
 
                    void   HGPU_program_add(HGPU_GPU_context* context,cl_program program);
+                   void   HGPU_program_registry_delete(HGPU_GPU_context* context);
+                   bool   HGPU_program_key_equal(const char* key1,const char* key2);
+                   char*  HGPU_program_get_options(HGPU_GPU_context* context,const char* options);
+       HGPU_parameter**  HGPU_program_get_cache_parameters(HGPU_GPU_context* context,const char* source,const char* options,char** cache_key);
+             cl_program   HGPU_program_build_to_cache(HGPU_GPU_context* context,const char* source,const char* options,
+                                                      HGPU_parameter** parameters,const char* cache_key);
+                   char*  HGPU_program_get_cache_key(const char* platform_name,const char* device_name,const char* driver,
+                                                     const char* options,const char* md5);
+             cl_program   HGPU_program_build_from_cache(HGPU_GPU_context* context,const char* cache_key,const char* options);
+                   bool   HGPU_program_cache_lock(const char* cache_key);
+                   void   HGPU_program_cache_unlock(const char* cache_key);
 
 // simple functions:
              cl_program   HGPU_program_build(cl_context context,cl_device_id device,const char* source,const char* options);
@@ -45,7 +45,7 @@
     typedef struct{
                            cl_mem   buffer;
                              char*  name;                              // buffer's name
-                             void*  host_ptr;
+                             void*  host_ptr;                          // page-aligned host memory used by device in place (zero-copy buffers only)
                      unsigned int*  mapped_ptr;                        // ptr to corresponding host memory after mapping
                            size_t   size;
                            size_t   sizeof_element;                    // sizeof buffer element ( sizeof(...) )
@@ -66,6 +66,31 @@
     } HGPU_GPU_buffer;
 
 
+    // structure for pool of released buffers (recycled cl_mem objects and host memory of the same size class)
+    typedef struct{
+                           cl_mem   buffer[HGPU_GPU_MAX_POOLED_BUFFERS];
+                     cl_mem_flags   buffer_flags[HGPU_GPU_MAX_POOLED_BUFFERS];
+                           size_t   buffer_size[HGPU_GPU_MAX_POOLED_BUFFERS];      // size of cl_mem object (in bytes)
+                     unsigned int   number_of_buffers;
+                             void*  host_ptr[HGPU_GPU_MAX_POOLED_BUFFERS];
+                           size_t   host_size[HGPU_GPU_MAX_POOLED_BUFFERS];        // size of host memory (in bytes)
+                     unsigned int   number_of_host_ptrs;
+                // statistics ______________________________
+                        long long   buffer_hits;
+                        long long   buffer_misses;
+                        long long   host_hits;
+                        long long   host_misses;
+    } HGPU_GPU_buffer_pool;
+
+
+    // structure for registry of programs (program is shared by all kernels with the same source and options)
+    typedef struct{
+                       cl_program   program;
+                             char*  name;                   // program source (or name of source file)
+                             char*  options;                // build options
+    } HGPU_GPU_program_entry;
+
+
     // structure for debug flags
     typedef struct{
                            size_t   max_workgroup_size; // maximum workgroup size for kernels
@@ -77,6 +102,11 @@
                              bool   rebuild_binaries;
                              bool   warning_error;
                              bool   no_cache;
+                             bool   out_of_order;       // out-of-order execution of compute queue
+                             bool   transfer_queue;     // separate queue for buffer transfers
+                             bool   device_fission;     // partition CPU devices into NUMA-local sub-devices (one context per sub-device)
+                             bool   no_buffer_pool;     // do not recycle released buffers
+                             bool   no_zero_copy;       // do not use host memory in place on devices with unified memory
     } HGPU_GPU_debug;
 
 
@@ -99,6 +129,7 @@
         size_t   memory_align_factor;    // memory align factor for buffers (=CL_DEVICE_MAX_COMPUTE_UNITS)
         HGPU_GPU_vendor   platform_vendor;        // platform vendor
         HGPU_GPU_vendor   device_vendor;          // device vendor
+        bool   host_unified_memory;    // CL_DEVICE_HOST_UNIFIED_MEMORY (or CPU device)
     } HGPU_GPU_device_info;
 
 
@@ -116,6 +147,8 @@
                            double   kernel_elapsed_time;           // total kernel execution time (in nanoseconds)
                            double   kernel_elapsed_time_squared;   // total kernel execution time squared (in nanoseconds) - for deviation calculation
                         long long   kernel_number_of_starts;       // total number of kernel starts - for deviation calculation
+                         cl_event   kernel_events_pending[HGPU_GPU_MAX_PENDING_EVENTS]; // retained events of asynchronous runs (profiled lazily)
+                     unsigned int   kernel_events_pending_number;  // number of retained events of asynchronous runs
     } HGPU_GPU_kernel;
 
 
@@ -125,11 +158,16 @@
              HGPU_GPU_device_info   device_info;
                        cl_context   context;
                  cl_command_queue   queue;
+                 cl_command_queue   queue_transfer;         // queue for buffer transfers with wait lists (equal to queue without TRANSFER_QUEUE)
+                         cl_event   queue_transfer_event;   // last command of transfer queue (commands without wait list follow it)
                    HGPU_GPU_debug   debug_flags;
                      unsigned int   number_of_programs;
                        cl_program*  program;
+                     unsigned int   number_of_program_entries;
+           HGPU_GPU_program_entry*  program_entry;          // registry of programs for reuse
                   HGPU_GPU_kernel** kernel;
                   HGPU_GPU_buffer** buffer;
+             HGPU_GPU_buffer_pool*  buffer_pool;            // released buffers for recycling (NULL with NO_BUFFER_POOL)
     } HGPU_GPU_context;
 
 
@@ -61,16 +61,27 @@
 #include <malloc.h>
 #include <algorithm>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
 
 #ifdef _WIN32
 #include <windows.h>
 #include <conio.h>
 #include <direct.h>
+#include <io.h>
+#include <process.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <string>
 #else  // _WIN32
 //#include <pthread.h>
 #include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <signal.h>
+#include <errno.h>
 #endif // _WIN32
 
 #include <math.h>
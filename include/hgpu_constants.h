@@ -78,6 +78,20 @@
 #define HGPU_PRECISION_DOUBLE           "DOUBLE"
 #define HGPU_PRECISION_MIXED             "MIXED"
 
+// PRNG output distribution constants
+#define HGPU_PRNG_DISTRIBUTION_UNIFORM      "UNIFORM"
+#define HGPU_PRNG_DISTRIBUTION_NORMAL       "NORMAL"
+#define HGPU_PRNG_DISTRIBUTION_NORMAL_POLAR "NORMAL_POLAR"
+#define HGPU_PRNG_DISTRIBUTION_LOGNORMAL    "LOGNORMAL"
+#define HGPU_PRNG_DISTRIBUTION_EXPONENTIAL  "EXPONENTIAL"
+#define HGPU_PRNG_DISTRIBUTION_POISSON      "POISSON"
+#define HGPU_PRNG_DISTRIBUTION_GAMMA        "GAMMA"
+
+// PRNG output format constants
+#define HGPU_PRNG_OUTPUT_FLOAT              "FLOAT"
+#define HGPU_PRNG_OUTPUT_UINT32             "UINT32"
+#define HGPU_PRNG_OUTPUT_UINT64             "UINT64"
+
 // string constants
 #define HGPU_MAX_STR_INFO_LENGHT            4096    ///<  maximal length of the temporary buffers
 #define HGPU_MAX_FILE_READ_BUFFER           8192    ///<  maximal length for reading buffer
@@ -108,6 +122,11 @@
 #define HGPU_PARAMETER_WARNING_ERROR           "WARNING_ERROR"
 #define HGPU_PARAMETER_NO_CACHE                "NO_CACHE"
 #define HGPU_PARAMETER_MAX_WORKGROUP_SIZE      "MAX_WORKGROUP_SIZE"
+#define HGPU_PARAMETER_OUT_OF_ORDER            "OUT_OF_ORDER"
+#define HGPU_PARAMETER_TRANSFER_QUEUE          "TRANSFER_QUEUE"
+#define HGPU_PARAMETER_DEVICE_FISSION          "DEVICE_FISSION"
+#define HGPU_PARAMETER_NO_BUFFER_POOL          "NO_BUFFER_POOL"
+#define HGPU_PARAMETER_NO_ZERO_COPY            "NO_ZERO_COPY"
 #define HGPU_PARAMETER_DEVICES_NUMBER          "DEVICES_NUMBER"
 #define HGPU_PARAMETER_PRNG                    "PRNG"
 #define HGPU_PARAMETER_PRNG_RANDSERIES         "PRNG_RANDSERIES"
@@ -119,12 +138,23 @@
 #define HGPU_PARAMETER_PRNG_SEED3              "PRNG_SEED3"
 #define HGPU_PARAMETER_PRNG_SEED4              "PRNG_SEED4"
 #define HGPU_PARAMETER_PRNG_RANLUX_NSKIP       "PRNG_RANLUX_NSKIP"
+#define HGPU_PARAMETER_PRNG_SKIP               "PRNG_SKIP"
+#define HGPU_PARAMETER_PRNG_SUBSTREAM          "PRNG_SUBSTREAM"
+#define HGPU_PARAMETER_PRNG_DISTRIBUTION       "PRNG_DISTRIBUTION"
+#define HGPU_PARAMETER_PRNG_NORMAL_MEAN        "PRNG_NORMAL_MEAN"
+#define HGPU_PARAMETER_PRNG_NORMAL_SIGMA       "PRNG_NORMAL_SIGMA"
+#define HGPU_PARAMETER_PRNG_LAMBDA             "PRNG_LAMBDA"
+#define HGPU_PARAMETER_PRNG_GAMMA_SHAPE        "PRNG_GAMMA_SHAPE"
+#define HGPU_PARAMETER_PRNG_GAMMA_SCALE        "PRNG_GAMMA_SCALE"
+#define HGPU_PARAMETER_PRNG_OUTPUT             "PRNG_OUTPUT"
+#define HGPU_PARAMETER_PRNG_STREAM             "PRNG_STREAM"
 #define HGPU_PARAMETER_PRNG_TEST_MAX_PASSES    "PRNG_TEST_MAX_DURATION"
 #define HGPU_PARAMETER_PRNG_TEST_MAX_DURATION  "PRNG_TEST_MAX_DURATION"
 
 #define HGPU_PARAMETER_INF_PLATFORM            "PLATFORM"
 #define HGPU_PARAMETER_INF_DEVICE              "DEVICE"
 #define HGPU_PARAMETER_INF_MD5                 "MD5"
+#define HGPU_PARAMETER_INF_DRIVER              "DRIVER"
 #define HGPU_PARAMETER_INF_NUMBER              "NUMBER"
 #define HGPU_PARAMETER_INF_OPTIONS             "OPTIONS"
 #define HGPU_PARAMETER_INF_DATE                "DATE"
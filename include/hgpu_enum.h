@@ -60,6 +60,22 @@
             HGPU_PRNG_output_type_double4       // PRNG returns (double4)s only (double precision)
     } HGPU_PRNG_output_type;
 
+    typedef enum enum_HGPU_PRNG_distribution {
+            HGPU_PRNG_distribution_uniform,         // uniform distribution of PRNs in (0,1)
+            HGPU_PRNG_distribution_normal,          // normal distribution (Box-Muller transform)
+            HGPU_PRNG_distribution_normal_polar,    // normal distribution (Marsaglia polar method)
+            HGPU_PRNG_distribution_lognormal,       // log-normal distribution (exponent of normal distribution)
+            HGPU_PRNG_distribution_exponential,     // exponential distribution (inversion)
+            HGPU_PRNG_distribution_poisson,         // Poisson distribution (inversion or PTRS rejection)
+            HGPU_PRNG_distribution_gamma            // Gamma distribution (Marsaglia-Tsang rejection)
+    } HGPU_PRNG_distribution;
+
+    typedef enum enum_HGPU_PRNG_output_format {
+            HGPU_PRNG_output_format_float,          // floating point PRNs in PRNG precision (hgpu_float4)
+            HGPU_PRNG_output_format_uint32,         // raw 32-bit unsigned integer PRNs (uint4)
+            HGPU_PRNG_output_format_uint64          // raw 64-bit unsigned integer PRNs from pairs of 32-bit PRNs (ulong2)
+    } HGPU_PRNG_output_format;
+
     typedef enum enum_HGPU_GPU_vendors{
         HGPU_GPU_vendor_none   = 0,             //
         HGPU_GPU_vendor_amd    = 1,             // Advanced Micro Devices, Inc.
@@ -77,7 +93,8 @@
         HGPU_GPU_buffer_type_output   = 4,      // Output buffer type
         HGPU_GPU_buffer_type_constant = 5,      // Constant buffer type
         HGPU_GPU_buffer_type_local    = 6,      // Local buffer type
-        HGPU_GPU_buffer_type_uav      = 7       // UAV buffer type
+        HGPU_GPU_buffer_type_uav      = 7,      // UAV buffer type
+        HGPU_GPU_buffer_type_device   = 8       // like Global buffer, but without host copy (could be mapped to host)
     } HGPU_GPU_buffer_types;
 
     HGPU_precision   HGPU_convert_precision_from_uint(unsigned int precision_code);
@@ -85,6 +102,14 @@
         const char*  HGPU_convert_precision_to_str(HGPU_precision precision);
       unsigned int   HGPU_convert_precision_to_uint(HGPU_precision precision);
 
+HGPU_PRNG_distribution   HGPU_convert_distribution_from_uint(unsigned int distribution_code);
+HGPU_PRNG_distribution   HGPU_convert_distribution_from_str(const char* distribution);
+        const char*  HGPU_convert_distribution_to_str(HGPU_PRNG_distribution distribution);
+
+HGPU_PRNG_output_format  HGPU_convert_output_format_from_uint(unsigned int output_format_code);
+HGPU_PRNG_output_format  HGPU_convert_output_format_from_str(const char* output_format);
+        const char*  HGPU_convert_output_format_to_str(HGPU_PRNG_output_format output_format);
+
 #ifdef HGPU_data_type_none
             size_t   HGPU_convert_data_type_to_size_t(HGPU_data_type data_type);
 #endif
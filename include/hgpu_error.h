@@ -65,6 +65,9 @@
 #define HGPU_ERROR_BAD_CONTEXT                         2112 // bad context
 #define HGPU_ERROR_BAD_PRNG                            2113 // bad PRNG
 #define HGPU_ERROR_BAD_PRNG_INIT                       2114 // bad PRNG initialization
+#define HGPU_ERROR_BAD_PRNG_SKIP                       2115 // PRNG skip-ahead is not supported
+#define HGPU_ERROR_BAD_PRNG_DISTRIBUTION               2116 // bad parameters of PRNG output distribution
+#define HGPU_ERROR_BAD_PRNG_OUTPUT                     2117 // PRNG output format is not supported
 // negative codes are for OpenCL errors
 
             void  HGPU_error(int error_code);
@@ -65,12 +65,16 @@
                    bool   HGPU_io_file_check_existence(const char* file_name);
                    bool   HGPU_io_file_check_existence_with_path(const char* file_path,const char* file_name);
 
-                    int   HGPU_io_inf_file_delete(int inf_index);
-                   void   HGPU_io_inf_file_delete_all(void);
-                    int   HGPU_io_inf_file_rename(int inf_index_old,int inf_index_new);
-                    int   HGPU_io_inf_file_get_max_index(void);
-                   bool   HGPU_io_inf_file_check_existence(int inf_index);
+                   bool   HGPU_io_file_write_binary_atomic(const char* file_name,const unsigned char* buffer,const size_t bytes_to_write);
 
-                   bool   HGPU_io_bin_file_check_existence(int inf_index);
-          unsigned char*  HGPU_io_bin_file_read(int inf_index,size_t* binary_size);
+                   void   HGPU_io_cache_file_get_name(char** file_name,const char* cache_key,const char* extension);
+                    int   HGPU_io_inf_file_delete(const char* cache_key);
+                   bool   HGPU_io_lock_file_acquire(const char* cache_key);
+                   void   HGPU_io_lock_file_release(const char* cache_key);
+                   bool   HGPU_io_lock_file_check_existence(const char* cache_key);
+                 double   HGPU_io_lock_file_get_age(const char* cache_key);
+                   bool   HGPU_io_lock_file_check_orphaned(const char* cache_key);
+
+                   bool   HGPU_io_bin_file_check_existence(const char* cache_key);
+          unsigned char*  HGPU_io_bin_file_read(const char* cache_key,size_t* binary_size);
 #endif
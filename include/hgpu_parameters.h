@@ -60,13 +60,12 @@
          HGPU_parameter** HGPU_parameters_get_from_file_with_path(const char* file_path,const char* file_name);
          HGPU_parameter** HGPU_parameters_get_from_commandline(int argc, char** argv);
          HGPU_parameter** HGPU_parameters_get_from_environment(void);
-         HGPU_parameter** HGPU_parameters_get_from_inf_file(int index);
          HGPU_parameter** HGPU_parameters_get_all(int argc, char** argv);
 
          HGPU_precision   HGPU_parameters_get_precision(HGPU_parameter** parameters,const char* parameter_name);
 
                    char*  HGPU_parameters_put(HGPU_parameter** parameters);
-                   void   HGPU_parameters_write_to_inf_file(HGPU_parameter** parameters,const unsigned char* binary,const size_t bytes_in_binary,int inf_index);
+                   void   HGPU_parameters_write_to_inf_file(HGPU_parameter** parameters,const unsigned char* binary,const size_t bytes_in_binary,const char* cache_key);
 
          HGPU_parameter*  HGPU_parameter_new(void);
                    void   HGPU_parameter_delete(HGPU_parameter** parameter);
@@ -60,6 +60,11 @@ static const char slash[] = "/";
 #define memcpy_s(destination, destination_length, source, len) (memcpy(destination, source, len))
 #define strcat_s(newtext, replength, resorc, lenz) (strcat(newtext, resorc))
 #define Sleep(tm) { for(int i=1;i<=(int) (tm/CLOCKS_PER_SEC);i++) sleep(1); }
+#define _fileno(stream) fileno(stream)
+#define _fdopen(fd, mode) fdopen(fd, mode)
+#define _dup(fd) dup(fd)
+#define _dup2(fd1, fd2) dup2(fd1, fd2)
+#define _getpid() getpid()
 #endif
 #define strlen_s(str)       ( (str) ? strlen(str) : 0 )
 
@@ -46,6 +46,36 @@
             HGPU_PRNG_descriptions[i++] = prng;                                     \
         };
 
+#define HGPU_PRNG_DISTRIBUTION_2PI     (6.283185307179586476925286766559)
+#define HGPU_PRNG_DISTRIBUTION_MIN_FP  (5.42101086242752217003726400434970855712890625E-20) // 1/2^64 (to avoid log(0))
+#define HGPU_PRNG_POISSON_MAX_K        1024    // upper bound of Poisson PRNs produced by inversion
+#define HGPU_PRNG_POISSON_LARGE_LAMBDA (10.0)  // Poisson PRNs are produced by PTRS method for lambda>=HGPU_PRNG_POISSON_LARGE_LAMBDA
+#define HGPU_PRNG_COPY_BLOCK           32      // tile size of randoms buffer transpose in HGPU_PRNG_GPU_copy_to_host
+#define HGPU_PRNG_COPY_CHUNK           1048576 // number of PRNs copied to host at once by output writers
+#define HGPU_PRNG_BINARY_CHUNK         16777216 // number of bytes written at once by binary output writers
+#define HGPU_PRNG_PRODUCE_FLUSH        32      // number of passes enqueued by HGPU_PRNG_produce_n between queue flushes
+#define HGPU_PRNG_MULTI_CALIBRATION    16      // number of passes in productivity measurement of devices in HGPU_PRNG_multi_init
+
+// constants of PRNG output distribution (for OpenCL compilation options and CPU reference)
+typedef struct {
+    double  lambda;                 // rate of exponential distribution, mean of Poisson distribution
+    double  exp_lambda;             // exp(-lambda)
+    double  log_lambda;             // log(lambda)
+    bool    poisson_large;          // Poisson PRNs are produced by PTRS method
+    double  ptrs_a;                 // PTRS constants
+    double  ptrs_b;
+    double  ptrs_vr;
+    double  ptrs_log_inv_alpha;
+    double  gamma_d;                // shape-1/3 (shape+1-1/3 for shape<1)
+    double  gamma_c;                // 1/sqrt(9*gamma_d)
+    double  gamma_scale;            // scale of Gamma distribution
+    double  gamma_boost;            // 1/shape for shape<1 (0 otherwise)
+} HGPU_PRNG_distribution_constants;
+
+static void HGPU_PRNG_set_skip_with_parameters(HGPU_PRNG* prng,HGPU_parameter** parameters,bool reseeded);
+static void HGPU_PRNG_set_distribution_with_parameters(HGPU_PRNG* prng,HGPU_parameter** parameters);
+static void HGPU_PRNG_GPU_skip_substreams(HGPU_GPU_context* context,HGPU_PRNG* prng,u64_T n,u64_T stride);
+
 const HGPU_PRNG_description*  HGPU_PRNG_descriptions[HGPU_PRNG_MAX_descriptions];
                         int   HGPU_PRNG_descriptions_number = 0;
 
@@ -131,6 +161,86 @@ HGPU_PRNG_double_get_k(int bitness){
     return result;
 }
 
+// a^n mod m (skip-ahead for multiplicative congruential PRNGs)
+u32_T
+HGPU_PRNG_skip_powmod(u32_T a,u64_T n,u32_T m){
+    u64_T result = 1 % m;
+    u64_T base   = a % m;
+    while (n) {
+        if (n & 1) result = (result * base) % m;
+        base = (base * base) % m;
+        n >>= 1;
+    }
+    return (u32_T) result;
+}
+
+static void
+HGPU_PRNG_skip_matrix_mulmod(const u32_T* a,const u32_T* b,u32_T m,u32_T* result){
+    u32_T c[9];
+    for (int i=0; i<3; i++)
+        for (int j=0; j<3; j++) {
+            u64_T s = 0;
+            for (int k=0; k<3; k++) s = (s + ((u64_T) a[3*i+k] * b[3*k+j]) % m) % m;
+            c[3*i+j] = (u32_T) s;
+        }
+    memcpy(result,c,sizeof(c));
+}
+
+// matrix^n mod m for 3x3 matrix (skip-ahead for multiple recursive PRNGs)
+void
+HGPU_PRNG_skip_matrix_powmod(const u32_T* matrix,u64_T n,u32_T m,u32_T* result){
+    u32_T base[9];
+    memcpy(base,matrix,sizeof(base));
+    for (int i=0; i<9; i++) result[i] = ((i % 4) == 0) ? (1 % m) : 0;
+    while (n) {
+        if (n & 1) HGPU_PRNG_skip_matrix_mulmod(result,base,m,result);
+        HGPU_PRNG_skip_matrix_mulmod(base,base,m,base);
+        n >>= 1;
+    }
+}
+
+// x^n mod P(x) over GF(2) (skip-ahead for F2-linear PRNGs)
+// P(x) has degree 32*words, its leading coefficient is implicit; result has (words) 32-bit words
+void
+HGPU_PRNG_skip_gf2_powmod(const u32_T* polynomial,unsigned int words,u64_T n,u32_T* result){
+    const unsigned int max_words = 8;
+    if ((!words) || (words>max_words)) {
+        HGPU_error_note(HGPU_ERROR_BAD_PRNG_SKIP,"polynomial is too long for skip-ahead");
+        return;
+    }
+    unsigned int degree = 32 * words;
+    u32_T square[2*max_words];
+    for (unsigned int i=0; i<words; i++) result[i] = 0;
+    result[0] = 1;
+
+    int bit = 63;
+    while ((bit>=0) && (!((n >> bit) & 1))) bit--;
+    for (; bit>=0; bit--) {
+        // result = result^2 mod P
+        memset(square,0,sizeof(square));
+        for (unsigned int i=0; i<degree; i++)
+            if ((result[i>>5] >> (i&31)) & 1) square[(2*i)>>5] |= 1u << ((2*i)&31);
+        for (unsigned int i=2*degree-1; i>=degree; i--) {
+            if (!((square[i>>5] >> (i&31)) & 1)) continue;
+            square[i>>5] ^= 1u << (i&31);
+            unsigned int shift = i - degree;
+            for (unsigned int k=0; k<words; k++) {
+                square[k + (shift>>5)] ^= polynomial[k] << (shift&31);
+                if (shift&31) square[k + (shift>>5) + 1] ^= polynomial[k] >> (32 - (shift&31));
+            }
+        }
+        for (unsigned int i=0; i<words; i++) result[i] = square[i];
+
+        // result = result*x mod P
+        if ((n >> bit) & 1) {
+            u32_T carry = result[words-1] >> 31;
+            for (unsigned int i=words-1; i>0; i--) result[i] = (result[i] << 1) | (result[i-1] >> 31);
+            result[0] <<= 1;
+            if (carry) for (unsigned int i=0; i<words; i++) result[i] ^= polynomial[i];
+        }
+    }
+}
+
 const HGPU_PRNG_description**
 HGPU_PRNG_descriptions_new(void){ 
     int i = 0;
@@ -142,6 +252,7 @@ HGPU_PRNG_descriptions_new(void){
     HGPU_PRNG_INCLUDE(HGPU_PRNG_RANLUX);
     HGPU_PRNG_INCLUDE(HGPU_PRNG_PM);
     HGPU_PRNG_INCLUDE(HGPU_PRNG_MRG32K3A);
+    HGPU_PRNG_INCLUDE(HGPU_PRNG_PHILOX);
     HGPU_PRNG_INCLUDE(NULL);
     HGPU_PRNG_descriptions_number = (i-1);
     return HGPU_PRNG_descriptions;
@@ -189,8 +300,9 @@ HGPU_PRNG_description_get_with_name(const char* prng_name){
     return description;
 }
 
-HGPU_PRNG*
-HGPU_PRNG_new(const HGPU_PRNG_description* prng_descr){
+// allocate PRNG with default parameters, but without seeding (internal state of HGPU_PRNG_rand32bit is not changed)
+static HGPU_PRNG*
+HGPU_PRNG_alloc(const HGPU_PRNG_description* prng_descr){
     HGPU_PRNG* prng = (HGPU_PRNG*) calloc(1,sizeof(HGPU_PRNG));
     if (!prng)
         HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for PRNG_description");
@@ -206,7 +318,20 @@ HGPU_PRNG_new(const HGPU_PRNG_description* prng_descr){
     prng->parameters->id_buffer_seeds       = HGPU_GPU_MAX_BUFFERS;
     prng->parameters->id_buffer_randoms     = HGPU_GPU_MAX_BUFFERS;
     prng->parameters->id_kernel_produce     = HGPU_GPU_MAX_KERNELS;
+    prng->parameters->id_kernel_skip        = HGPU_GPU_MAX_KERNELS;
+    prng->parameters->distribution          = HGPU_PRNG_distribution_uniform;
+    prng->parameters->normal_mean           = 0.0;
+    prng->parameters->normal_sigma          = 1.0;
+    prng->parameters->lambda                = 1.0;
+    prng->parameters->gamma_shape           = 1.0;
+    prng->parameters->gamma_scale           = 1.0;
+    prng->parameters->output_format         = HGPU_PRNG_output_format_float;
+    return prng;
+}
 
+HGPU_PRNG*
+HGPU_PRNG_new(const HGPU_PRNG_description* prng_descr){
+    HGPU_PRNG* prng = HGPU_PRNG_alloc(prng_descr);
     HGPU_PRNG_set_samples(   prng,HGPU_PRNG_default_samples);
     HGPU_PRNG_set_instances( prng,HGPU_PRNG_default_instances);
     HGPU_PRNG_set_precision( prng,HGPU_PRNG_default_precision);
@@ -230,6 +355,8 @@ HGPU_PRNG*
 HGPU_PRNG_new_with_parameters(HGPU_parameter** parameters){
     HGPU_PRNG* prng = HGPU_PRNG_new(HGPU_PRNG_description_get_with_parameters(parameters));
     if (prng->prng->parameter_init) (prng->prng->parameter_init)(prng->state,parameters);
+    HGPU_PRNG_set_skip_with_parameters(prng,parameters,true);
+    HGPU_PRNG_set_distribution_with_parameters(prng,parameters);
     return prng;
 }
 
@@ -244,6 +371,7 @@ HGPU_PRNG_free(HGPU_PRNG* prng){
 void
 HGPU_PRNG_and_buffers_free(HGPU_GPU_context* context,HGPU_PRNG* prng){
     // release all buffers
+    HGPU_PRNG_pipeline_release(context,prng);
     HGPU_GPU_context_buffer_release(context,prng->parameters->id_buffer_input_seeds);
     HGPU_GPU_context_buffer_release(context,prng->parameters->id_buffer_seeds);
     HGPU_GPU_context_buffer_release(context,prng->parameters->id_buffer_randoms);
@@ -338,6 +466,74 @@ HGPU_PRNG_set_samples(HGPU_PRNG* prng,unsigned int samples){
     prng->parameters->samples = samples;
 }
 
+void
+HGPU_PRNG_set_substream(HGPU_PRNG* prng,u64_T substream){
+    prng->parameters->substream = substream;
+}
+
+void
+HGPU_PRNG_set_distribution(HGPU_PRNG* prng,HGPU_PRNG_distribution distribution){
+    prng->parameters->distribution = distribution;
+}
+
+void
+HGPU_PRNG_set_normal(HGPU_PRNG* prng,double mean,double sigma){
+    prng->parameters->normal_mean  = mean;
+    prng->parameters->normal_sigma = sigma;
+}
+
+void
+HGPU_PRNG_set_lambda(HGPU_PRNG* prng,double lambda){
+    if (lambda<=0.0) {
+        HGPU_error_note(HGPU_ERROR_BAD_PRNG_DISTRIBUTION,"lambda should be positive");
+        return;
+    }
+    prng->parameters->lambda = lambda;
+}
+
+void
+HGPU_PRNG_set_gamma(HGPU_PRNG* prng,double shape,double scale){
+    if ((shape<=0.0) || (scale<=0.0)) {
+        HGPU_error_note(HGPU_ERROR_BAD_PRNG_DISTRIBUTION,"shape and scale of Gamma distribution should be positive");
+        return;
+    }
+    prng->parameters->gamma_shape = shape;
+    prng->parameters->gamma_scale = scale;
+}
+
+// raw integer output is supported by PRNGs with integer output type only
+void
+HGPU_PRNG_set_output_format(HGPU_PRNG* prng,HGPU_PRNG_output_format output_format){
+    if ((output_format!=HGPU_PRNG_output_format_float) &&
+        (((prng->prng->output_type != HGPU_PRNG_output_type_uint)  &&
+          (prng->prng->output_type != HGPU_PRNG_output_type_uint4) &&
+          (prng->prng->output_type != HGPU_PRNG_output_type_uint4by1)) || (!prng->prng->CPU_produce_one_uint))) {
+        HGPU_error_note(HGPU_ERROR_BAD_PRNG_OUTPUT,"integer output is supported only by PRNGs with integer output type");
+        return;
+    }
+    prng->parameters->output_format = output_format;
+}
+
+static HGPU_PRNG_distribution_constants
+HGPU_PRNG_distribution_constants_get(HGPU_PRNG* prng){
+    HGPU_PRNG_distribution_constants result;
+    double lambda = prng->parameters->lambda;
+    double shape  = prng->parameters->gamma_shape;
+    result.lambda        = lambda;
+    result.exp_lambda    = exp(-lambda);
+    result.log_lambda    = log(lambda);
+    result.poisson_large = (lambda>=HGPU_PRNG_POISSON_LARGE_LAMBDA);
+    result.ptrs_b        = 0.931 + 2.53 * sqrt(lambda);
+    result.ptrs_a        = -0.059 + 0.02483 * result.ptrs_b;
+    result.ptrs_vr       = 0.9277 - 3.6224 / (result.ptrs_b - 2.0);
+    result.ptrs_log_inv_alpha = log(1.1239 + 1.1328 / (result.ptrs_b - 3.4));
+    result.gamma_d       = ((shape<1.0) ? (shape + 1.0) : shape) - 1.0 / 3.0;
+    result.gamma_c       = 1.0 / sqrt(9.0 * result.gamma_d);
+    result.gamma_scale   = prng->parameters->gamma_scale;
+    result.gamma_boost   = (shape<1.0) ? (1.0 / shape) : 0.0;
+    return result;
+}
+
 void
 HGPU_PRNG_change_samples(HGPU_GPU_context* context,HGPU_PRNG* prng,unsigned int samples){
     unsigned int kernel_id = prng->parameters->id_kernel_produce;
@@ -362,10 +558,139 @@ HGPU_PRNG_set_with_parameters(HGPU_PRNG* prng,HGPU_parameter** parameters){
     HGPU_parameter* parameter_instances  = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_INSTANCES);
     if (parameter_instances && (parameter_instances->value_text)) HGPU_PRNG_set_instances(prng,parameter_instances->value_integer);
 
+    bool reseeded = false;
     HGPU_parameter* parameter_randseries = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_RANDSERIES);
-    if (parameter_randseries && (parameter_randseries->value_text)) HGPU_PRNG_set_randseries(prng,parameter_randseries->value_integer);
+    if (parameter_randseries && (parameter_randseries->value_text)) {
+        HGPU_PRNG_set_randseries(prng,parameter_randseries->value_integer);
+        reseeded = true;
+    }
+
+    HGPU_parameter* parameter_output     = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_OUTPUT);
+    if (parameter_output && (parameter_output->value_text)) {
+        if (strlen(parameter_output->value_text)>1)
+            HGPU_PRNG_set_output_format(prng,HGPU_convert_output_format_from_str(parameter_output->value_text));
+        else
+            HGPU_PRNG_set_output_format(prng,HGPU_convert_output_format_from_uint(parameter_output->value_integer));
+    }
 
     if (prng->prng->parameter_init) (prng->prng->parameter_init)(prng->state,parameters);
+    HGPU_PRNG_set_skip_with_parameters(prng,parameters,reseeded);
+    HGPU_PRNG_set_distribution_with_parameters(prng,parameters);
+}
+
+// skip-ahead parameters should be applied after (re)seeding of PRNG
+// (PRNG_SKIP is applied only to freshly seeded state, so repeated calls do not accumulate skips)
+static void
+HGPU_PRNG_set_skip_with_parameters(HGPU_PRNG* prng,HGPU_parameter** parameters,bool reseeded){
+    if ((!prng) || (!parameters)) return;
+    llu_T value = 0;
+
+    HGPU_parameter* parameter_substream = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_SUBSTREAM);
+    if (parameter_substream && (parameter_substream->value_text) && (sscanf_s(parameter_substream->value_text,"%llu",&value)==1))
+        HGPU_PRNG_set_substream(prng,value);
+
+    HGPU_parameter* parameter_skip      = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_SKIP);
+    if (reseeded && parameter_skip && (parameter_skip->value_text) && (sscanf_s(parameter_skip->value_text,"%llu",&value)==1))
+        HGPU_PRNG_skip(prng,value);
+}
+
+static void
+HGPU_PRNG_set_distribution_with_parameters(HGPU_PRNG* prng,HGPU_parameter** parameters){
+    if ((!prng) || (!parameters)) return;
+
+    HGPU_parameter* parameter_distribution = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_DISTRIBUTION);
+    if (parameter_distribution && (parameter_distribution->value_text)) {
+        if (strlen(parameter_distribution->value_text)>1)
+            HGPU_PRNG_set_distribution(prng,HGPU_convert_distribution_from_str(parameter_distribution->value_text));
+        else
+            HGPU_PRNG_set_distribution(prng,HGPU_convert_distribution_from_uint(parameter_distribution->value_integer));
+    }
+
+    HGPU_parameter* parameter_mean  = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_NORMAL_MEAN);
+    HGPU_parameter* parameter_sigma = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_NORMAL_SIGMA);
+    double mean  = prng->parameters->normal_mean;
+    double sigma = prng->parameters->normal_sigma;
+    if (parameter_mean  && (parameter_mean->value_text))  mean  = parameter_mean->value_double;
+    if (parameter_sigma && (parameter_sigma->value_text)) sigma = parameter_sigma->value_double;
+    HGPU_PRNG_set_normal(prng,mean,sigma);
+
+    HGPU_parameter* parameter_lambda = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_LAMBDA);
+    if (parameter_lambda && (parameter_lambda->value_text)) HGPU_PRNG_set_lambda(prng,parameter_lambda->value_double);
+
+    HGPU_parameter* parameter_shape = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_GAMMA_SHAPE);
+    HGPU_parameter* parameter_scale = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_GAMMA_SCALE);
+    double shape = prng->parameters->gamma_shape;
+    double scale = prng->parameters->gamma_scale;
+    if (parameter_shape && (parameter_shape->value_text)) shape = parameter_shape->value_double;
+    if (parameter_scale && (parameter_scale->value_text)) scale = parameter_scale->value_double;
+    HGPU_PRNG_set_gamma(prng,shape,scale);
+}
+
+// append OpenCL macro definition of floating point constant (exactly representable in hgpu_float) to options
+static void
+HGPU_PRNG_GPU_option_define(char* options,int* position,const char* name,double value,HGPU_precision precision){
+    int j2 = (*position);
+    if (precision==HGPU_precision_double)
+        j2 += sprintf_s(options+j2,HGPU_GPU_MAX_OPTIONS_LENGTH-j2," -D %s=%1.17e",name,value);
+    else
+        j2 += sprintf_s(options+j2,HGPU_GPU_MAX_OPTIONS_LENGTH-j2," -D %s=%1.9ef",name,(double) ((float) value));
+    (*position) = j2;
+}
+
+// make OpenCL compilation options for PRNG program
+static void
+HGPU_PRNG_GPU_options(HGPU_GPU_context* context,HGPU_PRNG* prng,char* options){
+    int  j2 = sprintf_s(options,HGPU_GPU_MAX_OPTIONS_LENGTH,"-I %s%s",HGPU_io_path_root,PRNGCL_ROOT_PATH);
+    if (prng->parameters->precision==HGPU_precision_double) j2 += sprintf_s(options+j2,HGPU_GPU_MAX_OPTIONS_LENGTH-j2," -D PRNG_PRECISION=2");
+#ifdef HGPU_PRNG_SKIP_CHECK
+    j2 += sprintf_s(options+j2,HGPU_GPU_MAX_OPTIONS_LENGTH-j2," -D PRNG_SKIP_CHECK");
+#endif
+
+    // raw integer output (prngcl_distribution.cl) ignores output distribution
+    HGPU_PRNG_output_format output_format = prng->parameters->output_format;
+    if (output_format!=HGPU_PRNG_output_format_float)
+        j2 += sprintf_s(options+j2,HGPU_GPU_MAX_OPTIONS_LENGTH-j2," -D PRNG_OUTPUT=%u",(unsigned int) output_format);
+
+    // output distribution of PRNs (prngcl_distribution.cl)
+    HGPU_PRNG_distribution distribution = prng->parameters->distribution;
+    if ((distribution!=HGPU_PRNG_distribution_uniform) && (output_format==HGPU_PRNG_output_format_float)) {
+        HGPU_PRNG_distribution_constants constants = HGPU_PRNG_distribution_constants_get(prng);
+        HGPU_precision precision = prng->parameters->precision;
+        j2 += sprintf_s(options+j2,HGPU_GPU_MAX_OPTIONS_LENGTH-j2," -D PRNG_DISTRIBUTION=%u",(unsigned int) distribution);
+        if ((distribution==HGPU_PRNG_distribution_normal) || (distribution==HGPU_PRNG_distribution_normal_polar) ||
+            (distribution==HGPU_PRNG_distribution_lognormal)) {
+            HGPU_PRNG_GPU_option_define(options,&j2,"PRNG_NORMAL_MEAN", prng->parameters->normal_mean, precision);
+            HGPU_PRNG_GPU_option_define(options,&j2,"PRNG_NORMAL_SIGMA",prng->parameters->normal_sigma,precision);
+        }
+        if ((distribution==HGPU_PRNG_distribution_exponential) || (distribution==HGPU_PRNG_distribution_poisson))
+            HGPU_PRNG_GPU_option_define(options,&j2,"PRNG_LAMBDA",constants.lambda,precision);
+        if (distribution==HGPU_PRNG_distribution_poisson) {
+            HGPU_PRNG_GPU_option_define(options,&j2,"PRNG_POISSON_EXP_LAMBDA",constants.exp_lambda,precision);
+            if (constants.poisson_large) {
+                j2 += sprintf_s(options+j2,HGPU_GPU_MAX_OPTIONS_LENGTH-j2," -D PRNG_POISSON_LARGE");
+                HGPU_PRNG_GPU_option_define(options,&j2,"PRNG_POISSON_LOG_LAMBDA",constants.log_lambda,precision);
+                HGPU_PRNG_GPU_option_define(options,&j2,"PRNG_PTRS_A",constants.ptrs_a,precision);
+                HGPU_PRNG_GPU_option_define(options,&j2,"PRNG_PTRS_B",constants.ptrs_b,precision);
+                HGPU_PRNG_GPU_option_define(options,&j2,"PRNG_PTRS_VR",constants.ptrs_vr,precision);
+                HGPU_PRNG_GPU_option_define(options,&j2,"PRNG_PTRS_LOG_INV_ALPHA",constants.ptrs_log_inv_alpha,precision);
+            }
+        }
+        if (distribution==HGPU_PRNG_distribution_gamma) {
+            HGPU_PRNG_GPU_option_define(options,&j2,"PRNG_GAMMA_D",constants.gamma_d,precision);
+            HGPU_PRNG_GPU_option_define(options,&j2,"PRNG_GAMMA_C",constants.gamma_c,precision);
+            HGPU_PRNG_GPU_option_define(options,&j2,"PRNG_GAMMA_SCALE",constants.gamma_scale,precision);
+            if (constants.gamma_boost)
+                HGPU_PRNG_GPU_option_define(options,&j2,"PRNG_GAMMA_BOOST",constants.gamma_boost,precision);
+        }
+    }
+
+    // additional particular options of PRNG
+    // include additional options for opencl
+    if (prng->prng->GPU_options) {
+        char* add_options = (*prng->prng->GPU_options)(context,prng->state,prng->parameters);
+        if ((add_options) && (strlen(add_options)>0)) j2 += sprintf_s(options+j2,HGPU_GPU_MAX_OPTIONS_LENGTH-j2," %s",add_options);
+        free(add_options);
+    }
 }
 
 unsigned int
@@ -396,25 +721,18 @@ HGPU_PRNG_init(HGPU_GPU_context* context,HGPU_PRNG* prng){
         prng->parameters->samples   = 1 + (prng->parameters->samples - 1) / prng->parameters->instances;
     }
 
-    char* prng_src = HGPU_io_file_read_with_path(HGPU_io_path_root,prng->prng->prng_src);
     char options[HGPU_GPU_MAX_OPTIONS_LENGTH];
-    int  j2 = sprintf_s(options,HGPU_GPU_MAX_OPTIONS_LENGTH,"-I %s%s",HGPU_io_path_root,PRNGCL_ROOT_PATH);
-    if (prng->parameters->precision==HGPU_precision_double) j2 += sprintf_s(options+j2,HGPU_GPU_MAX_OPTIONS_LENGTH-j2," -D PRNG_PRECISION=2");
-#ifdef HGPU_PRNG_SKIP_CHECK
-    j2 += sprintf_s(options+j2,HGPU_GPU_MAX_OPTIONS_LENGTH-j2," -D PRNG_SKIP_CHECK");
-#endif
-
-    // additional particular options of PRNG
-    // include additional options for opencl
-    if (prng->prng->GPU_options) {
-        char* add_options = (*prng->prng->GPU_options)(context,prng->state,prng->parameters);
-        if ((add_options) && (strlen(add_options)>0)) j2 += sprintf_s(options+j2,HGPU_GPU_MAX_OPTIONS_LENGTH-j2," %s",add_options);
-        free(add_options);
+    HGPU_PRNG_GPU_options(context,prng,options);
+
+    // compile opencl program (program of PRNG of the same type and options is shared by all its instances in context)
+    cl_program prg = HGPU_GPU_program_get_registered(context,prng->prng->prng_src,options);
+    if (!prg) {
+        char* prng_src = HGPU_PRNG_source_read(prng->prng->prng_src);
+        prg = HGPU_GPU_program_with_options_new(prng_src,options,context);
+        HGPU_GPU_program_register(context,prg,prng->prng->prng_src,options);
+        free(prng_src);
     }
 
-    // compile opencl program
-    cl_program prg = HGPU_GPU_program_with_options_new(prng_src,options,context);
-
     // make memory objects: prepare seed tables (input and working)
     // perform input seed table by PRNG subroutine
     (*prng->prng->GPU_init)(context,prng->state,prng->parameters);
@@ -438,24 +756,339 @@ HGPU_PRNG_init(HGPU_GPU_context* context,HGPU_PRNG* prng){
     if (PRNG_input_seeds_id<HGPU_GPU_MAX_BUFFERS)
         HGPU_GPU_context_buffer_release(context,PRNG_input_seeds_id);
 
-    // make working kernel
-    kernel_id   = HGPU_GPU_context_kernel_init(context,prg,prng->prng->production_kernel, 1,global_size,NULL);
-    if (PRNG_seeds_id<HGPU_GPU_MAX_BUFFERS)   HGPU_GPU_context_kernel_bind_buffer(context,kernel_id,PRNG_seeds_id);
-    if (PRNG_randoms_id<HGPU_GPU_MAX_BUFFERS) HGPU_GPU_context_kernel_bind_buffer(context,kernel_id,PRNG_randoms_id);
-    HGPU_GPU_context_kernel_bind_constant(context,kernel_id,&prng->parameters->samples,sizeof(prng->parameters->samples));
+    // make skip-ahead kernel
+    if ((PRNG_seeds_id<HGPU_GPU_MAX_BUFFERS) && (prng->prng->skip_kernel)) {
+        u64_T skip_n = 0;
+        unsigned int kernel_skip_id = HGPU_GPU_context_kernel_init(context,prg,prng->prng->skip_kernel,1,global_size,NULL);
+                     HGPU_GPU_context_kernel_bind_buffer(context,kernel_skip_id,PRNG_seeds_id);
+                     HGPU_GPU_context_kernel_bind_constant(context,kernel_skip_id,&skip_n,sizeof(cl_ulong));
+                     HGPU_GPU_context_kernel_bind_constant(context,kernel_skip_id,&skip_n,sizeof(cl_ulong));
+        prng->parameters->id_kernel_skip = kernel_skip_id;
+
+        // partition one stream among instances: instance i starts at i*substream
+        if (prng->parameters->substream) HGPU_PRNG_GPU_skip_substreams(context,prng,0,prng->parameters->substream);
+    } else if (prng->parameters->substream)
+        HGPU_GPU_error_note(HGPU_ERROR_BAD_PRNG_SKIP,"PRNG skip-ahead on GPU is not supported: substreams are ignored, instances are seeded independently");
+
+    // make working kernel (PRNs are produced by consumer kernels in case of device-side API)
+    if (!prng->parameters->device_api) {
+        const size_t local_size[] = {prng->parameters->local_size};  // local_size (set by PRNG additional options)
+        kernel_id = HGPU_GPU_context_kernel_init(context,prg,prng->prng->production_kernel, 1,global_size,
+                                                 (prng->parameters->local_size ? local_size : NULL));
+        if (PRNG_seeds_id<HGPU_GPU_MAX_BUFFERS)   HGPU_GPU_context_kernel_bind_buffer(context,kernel_id,PRNG_seeds_id);
+        if (PRNG_randoms_id<HGPU_GPU_MAX_BUFFERS) HGPU_GPU_context_kernel_bind_buffer(context,kernel_id,PRNG_randoms_id);
+        HGPU_GPU_context_kernel_bind_constant(context,kernel_id,&prng->parameters->samples,sizeof(prng->parameters->samples));
+    }
 
     prng->parameters->id_buffer_randoms = PRNG_randoms_id;
     prng->parameters->id_kernel_produce = kernel_id;
 
-    free(prng_src);
     return kernel_id;
 }
 
+// initialize PRNG for device-side API (prngcl_device.cl): only seed table is prepared, returns seed table buffer id
+unsigned int
+HGPU_PRNG_init_device_api(HGPU_GPU_context* context,HGPU_PRNG* prng){
+    if (!prng) {
+        HGPU_GPU_error_note(HGPU_ERROR_BAD_PRNG,"PRNG is not initialized");
+        return HGPU_GPU_MAX_BUFFERS;
+    }
+    prng->parameters->device_api = true;
+    HGPU_PRNG_init(context,prng);
+    return prng->parameters->id_buffer_seeds;
+}
+
+// compile consumer program prepended by PRNG source (consumer includes prngcl_device.cl for device-side API)
+cl_program
+HGPU_PRNG_program_new(HGPU_GPU_context* context,HGPU_PRNG* prng,const char* source){
+    cl_program result = NULL;
+    if ((!context) || (!prng) || (!prng->prng->prng_src) || (!source)) {
+        HGPU_GPU_error_note(HGPU_ERROR_BAD_PRNG_INIT,"bad PRNG initialization");
+        return result;
+    }
+    char* program_src = HGPU_PRNG_source_read(prng->prng->prng_src);
+    HGPU_string_join(&program_src,(char*) "\n");
+    HGPU_string_join(&program_src,(char*) source);
+
+    char options[HGPU_GPU_MAX_OPTIONS_LENGTH];
+    HGPU_PRNG_GPU_options(context,prng,options);
+    result = HGPU_GPU_program_with_options_new(program_src,options,context);
+
+    free(program_src);
+    return result;
+}
+
+// get OpenCL source embedded into binary (NULL if OpenCL-file is not embedded)
+const char*
+HGPU_PRNG_source_get_embedded(const char* file_name){
+    if (!file_name) return NULL;
+#ifdef PRNGCL_EMBEDDED_SOURCES
+    for (int i=0; HGPU_PRNG_embedded_sources[i].name; i++)
+        if (!strcmp(HGPU_PRNG_embedded_sources[i].name,file_name)) return HGPU_PRNG_embedded_sources[i].source;
+#endif
+    return NULL;
+}
+
+// read OpenCL source of PRNG: embedded one (if any), otherwise OpenCL-file relative to root path
+char*
+HGPU_PRNG_source_read(const char* file_name){
+    const char* source = HGPU_PRNG_source_get_embedded(file_name);
+    if (source) return HGPU_string_clone(source);
+    return HGPU_io_file_read_with_path(HGPU_io_path_root,file_name);
+}
+
+// precompile programs of all registered PRNGs for precisions (terminated by HGPU_precision_none) into program cache;
+// precisions==NULL means single precision and double precision (if device supports it), returns number of programs
+unsigned int
+HGPU_PRNG_precompile_all(HGPU_GPU_context* context,const HGPU_precision* precisions){
+    if (!context) {
+        HGPU_GPU_error_note(HGPU_ERROR_BAD_CONTEXT,"context is not initialized");
+        return 0;
+    }
+    HGPU_precision precisions_default[] = {HGPU_precision_single,HGPU_precision_double,HGPU_precision_none};
+    if (!HGPU_GPU_device_check_double_precision(context->device)) precisions_default[1] = HGPU_precision_none;
+    if (!precisions) precisions = precisions_default;
+
+    unsigned int number_of_precisions = 0;
+    while (precisions[number_of_precisions]!=HGPU_precision_none) number_of_precisions++;
+
+    const HGPU_PRNG_description** prng_all = HGPU_PRNG_descriptions_new();
+    unsigned int max_programs = HGPU_PRNG_descriptions_number * number_of_precisions;
+    if (!max_programs) return 0;
+    char** sources = (char**) calloc(max_programs,sizeof(char*));
+    char** options = (char**) calloc(max_programs,sizeof(char*));
+    if ((!sources) || (!options)) HGPU_error(HGPU_ERROR_NO_MEMORY);
+
+    // options of some PRNGs depend on seeded state, so PRNGs are seeded as in HGPU_PRNG_init,
+    // but internal state of HGPU_PRNG_rand32bit is restored afterwards (seeding of PRNGs created by caller is not changed)
+    HGPU_PRNG_internal_state_t internal_state = HGPU_PRNG_internal_state;
+    unsigned int number_of_programs = 0;
+    for (int i=0; i<HGPU_PRNG_descriptions_number; i++) {
+        if (!prng_all[i]->prng_src) continue;
+        for (unsigned int j=0; j<number_of_precisions; j++) {
+            // PRNG is prepared in the same way as in HGPU_PRNG_init to get the same program (and the same cache entry)
+            HGPU_PRNG* prng = HGPU_PRNG_new(prng_all[i]);
+            HGPU_PRNG_set_precision(prng,precisions[j]);
+            if (!prng->parameters->instances) {
+                prng->parameters->instances = HGPU_GPU_device_get_max_memory_width(context->device);
+                prng->parameters->samples   = 1 + (prng->parameters->samples - 1) / prng->parameters->instances;
+            }
+            sources[number_of_programs] = HGPU_PRNG_source_read(prng->prng->prng_src);
+            options[number_of_programs] = (char*) calloc(HGPU_GPU_MAX_OPTIONS_LENGTH,sizeof(char));
+            if (!options[number_of_programs]) HGPU_error(HGPU_ERROR_NO_MEMORY);
+            HGPU_PRNG_GPU_options(context,prng,options[number_of_programs]);
+            HGPU_PRNG_free(prng);
+            number_of_programs++;
+        }
+    }
+    HGPU_PRNG_internal_state = internal_state;
+
+    HGPU_GPU_programs_precompile(context,number_of_programs,(const char**) sources,(const char**) options);
+
+    for (unsigned int i=0; i<number_of_programs; i++) {
+        free(sources[i]);
+        free(options[i]);
+    }
+    free(sources);
+    free(options);
+    return number_of_programs;
+}
+
+// bind PRNG seed table to consumer kernel (null buffer for PRNGs without seed table)
+unsigned int
+HGPU_PRNG_kernel_bind_seeds(HGPU_GPU_context* context,unsigned int kernel_id,HGPU_PRNG* prng){
+    if ((!prng) || (prng->parameters->id_buffer_seeds>=HGPU_GPU_MAX_BUFFERS)) {
+        cl_mem no_buffer = NULL;
+        return HGPU_GPU_context_kernel_bind_constant(context,kernel_id,&no_buffer,sizeof(cl_mem));
+    }
+    return HGPU_GPU_context_kernel_bind_buffer(context,kernel_id,prng->parameters->id_buffer_seeds);
+}
+
+// allocate buffer for PRNs produced by PRNG (no buffer in case of device-side API)
+unsigned int
+HGPU_PRNG_GPU_randoms_init(HGPU_GPU_context* context,HGPU_PRNG_parameters* PRNG_parameters,const char* buffer_name){
+    unsigned int randoms_id = HGPU_GPU_MAX_BUFFERS;
+    if (PRNG_parameters->device_api) return randoms_id;
+
+    // randoms are produced on device: buffer is allocated without host copy
+    size_t randoms_size = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * PRNG_parameters->samples);
+    size_t sizeof_element = sizeof(cl_float4);
+    if (PRNG_parameters->output_format==HGPU_PRNG_output_format_uint32)
+        sizeof_element = sizeof(cl_uint4);
+    else if (PRNG_parameters->output_format==HGPU_PRNG_output_format_uint64)
+        sizeof_element = sizeof(cl_ulong2);
+    else if (PRNG_parameters->precision==HGPU_precision_double)
+        sizeof_element = sizeof(cl_double4);
+
+    randoms_id = HGPU_GPU_context_buffer_init(context,NULL,HGPU_GPU_buffer_type_device,randoms_size,sizeof_element);
+    HGPU_GPU_context_buffer_set_name(context,randoms_id,buffer_name);
+
+    return randoms_id;
+}
+
 void
 HGPU_PRNG_produce(HGPU_GPU_context* context,unsigned int prng_kernel_id){
     HGPU_GPU_context_kernel_run(context,prng_kernel_id);
 }
 
+// n passes of PRNs production, each one followed by run of consumer kernel (if consumer_kernel_id<HGPU_GPU_MAX_KERNELS):
+// all passes are enqueued back-to-back (in-order queue) and host waits only once for the last of them;
+// PRNG with device-side API has no production kernel, so only consumer kernel is run
+void
+HGPU_PRNG_produce_n(HGPU_GPU_context* context,HGPU_PRNG* prng,unsigned int n,unsigned int consumer_kernel_id){
+    if ((!context) || (!prng)) return;
+    unsigned int produce_kernel_id = prng->parameters->id_kernel_produce;
+    if ((produce_kernel_id>=HGPU_GPU_MAX_KERNELS) && (consumer_kernel_id>=HGPU_GPU_MAX_KERNELS)) {
+        HGPU_GPU_error_note(HGPU_ERROR_BAD_PRNG_INIT,"PRNG is not initialized");
+        return;
+    }
+    for (unsigned int i=0; i<n; i++) {
+        if (produce_kernel_id<HGPU_GPU_MAX_KERNELS)  HGPU_GPU_context_kernel_run_async(context,produce_kernel_id);
+        if (consumer_kernel_id<HGPU_GPU_MAX_KERNELS) HGPU_GPU_context_kernel_run_async(context,consumer_kernel_id);
+        if (!((i+1) % HGPU_PRNG_PRODUCE_FLUSH)) HGPU_GPU_context_queue_flush(context); // keep device busy while enqueueing
+    }
+    HGPU_GPU_context_queue_wait_for_finish(context);
+}
+
+// enqueue production of PRNs into pipeline buffer and its asynchronous mapping for consumer:
+// production follows previous production (PRNG state) and unmap of buffer, mapping follows production only,
+// so with OUT_OF_ORDER or TRANSFER_QUEUE mapping of one buffer overlaps with production into other one
+static void
+HGPU_PRNG_pipeline_enqueue(HGPU_GPU_context* context,HGPU_PRNG* prng,unsigned int index){
+    unsigned int kernel_id  = prng->parameters->id_kernel_produce;
+    unsigned int randoms_id = prng->parameters->id_buffer_pipeline[index];
+    cl_event     wait_list[2];
+    cl_uint      events_number = 0;
+    cl_event     produce_event = HGPU_GPU_context_kernel_get_event(context,kernel_id);
+    cl_event     unmap_event   = HGPU_GPU_context_buffer_get_write_event(context,randoms_id);
+    if (produce_event) wait_list[events_number++] = produce_event;
+    if (unmap_event)   wait_list[events_number++] = unmap_event;
+    HGPU_PRNG_kernel_bind_randoms(context,prng,randoms_id);
+    HGPU_GPU_context_kernel_run_async_wait_list(context,kernel_id,events_number,(events_number) ? wait_list : NULL);
+    produce_event = HGPU_GPU_context_kernel_get_event(context,kernel_id);
+    HGPU_GPU_context_buffer_map_async_wait_list(context,randoms_id,1,&produce_event);
+}
+
+// setup production pipeline of depth randoms buffers (1..HGPU_PRNG_PIPELINE_MAX_DEPTH) and start production into all of them;
+// returns depth of pipeline (0 if PRNG has no production kernel)
+unsigned int
+HGPU_PRNG_pipeline_init(HGPU_GPU_context* context,HGPU_PRNG* prng,unsigned int depth){
+    unsigned int result = 0;
+    if ((!context) || (!prng)) return result;
+    if ((prng->parameters->id_kernel_produce>=HGPU_GPU_MAX_KERNELS) || (prng->parameters->id_buffer_randoms>=HGPU_GPU_MAX_BUFFERS)) {
+        HGPU_GPU_error_note(HGPU_ERROR_BAD_PRNG_INIT,"PRNG is not initialized");
+        return result;
+    }
+    HGPU_PRNG_pipeline_release(context,prng);
+    depth = MAX(1,MIN(depth,HGPU_PRNG_PIPELINE_MAX_DEPTH));
+
+    // randoms buffer may be mapped by consumer
+    void* randoms = HGPU_GPU_buffer_get_by_index(context->buffer,prng->parameters->id_buffer_randoms)->mapped_ptr;
+    if (randoms) HGPU_GPU_context_buffer_unmap(context,prng->parameters->id_buffer_randoms,randoms);
+
+    prng->parameters->id_buffer_pipeline[0] = prng->parameters->id_buffer_randoms;
+    for (unsigned int i=1; i<depth; i++)
+        prng->parameters->id_buffer_pipeline[i] = HGPU_PRNG_GPU_randoms_init(context,prng->parameters,"PRNG_randoms_pipeline");
+    prng->parameters->pipeline_depth   = depth;
+    prng->parameters->pipeline_head    = 0;
+    prng->parameters->pipeline_current = depth;
+
+    // batches follow each other in PRNG sequence (the first one follows PRNG initialization and skip-ahead)
+    HGPU_GPU_context_queue_wait_for_finish(context);
+    for (unsigned int i=0; i<depth; i++) HGPU_PRNG_pipeline_enqueue(context,prng,i);
+    HGPU_GPU_context_queue_flush(context);
+    result = depth;
+    return result;
+}
+
+// hand out next produced randoms buffer (mapped, see HGPU_GPU_context_buffer_get_mapped) and return its id;
+// buffer handed out previously is given back to pipeline, so its content (and mapped pointer) becomes invalid
+unsigned int
+HGPU_PRNG_pipeline_next(HGPU_GPU_context* context,HGPU_PRNG* prng){
+    unsigned int result = HGPU_GPU_MAX_BUFFERS;
+    if ((!context) || (!prng) || (!prng->parameters->pipeline_depth)) {
+        HGPU_GPU_error_note(HGPU_ERROR_BAD_PRNG_INIT,"PRNG pipeline is not initialized");
+        return result;
+    }
+    HGPU_PRNG_parameters* parameters = prng->parameters;
+    if (parameters->pipeline_current<parameters->pipeline_depth) {
+        unsigned int randoms_id = parameters->id_buffer_pipeline[parameters->pipeline_current];
+        HGPU_GPU_context_buffer_unmap_async_wait_list(context,randoms_id,HGPU_GPU_buffer_get_by_index(context->buffer,randoms_id)->mapped_ptr,0,NULL);
+        HGPU_PRNG_pipeline_enqueue(context,prng,parameters->pipeline_current);
+        HGPU_GPU_context_queue_flush(context);
+    }
+    parameters->pipeline_current = parameters->pipeline_head;
+    parameters->pipeline_head    = (parameters->pipeline_head + 1) % parameters->pipeline_depth;
+    result = parameters->id_buffer_pipeline[parameters->pipeline_current];
+    HGPU_GPU_context_buffer_map_wait(context,result);
+    return result;
+}
+
+// stop production pipeline: PRNG continues with its own randoms buffer (unmapped)
+// after the last batch produced by pipeline (including batches, which were not handed out)
+void
+HGPU_PRNG_pipeline_release(HGPU_GPU_context* context,HGPU_PRNG* prng){
+    if ((!context) || (!prng) || (!prng->parameters->pipeline_depth)) return;
+    HGPU_GPU_context_queue_wait_for_finish(context);
+    for (unsigned int i=0; i<prng->parameters->pipeline_depth; i++) {
+        unsigned int randoms_id = prng->parameters->id_buffer_pipeline[i];
+        void* randoms = HGPU_GPU_buffer_get_by_index(context->buffer,randoms_id)->mapped_ptr;
+        if (randoms) HGPU_GPU_context_buffer_unmap(context,randoms_id,randoms);
+        if (i) HGPU_GPU_context_buffer_release(context,randoms_id);
+        prng->parameters->id_buffer_pipeline[i] = HGPU_GPU_MAX_BUFFERS;
+    }
+    HGPU_PRNG_kernel_bind_randoms(context,prng,prng->parameters->id_buffer_randoms);
+    prng->parameters->pipeline_depth   = 0;
+    prng->parameters->pipeline_head    = 0;
+    prng->parameters->pipeline_current = 0;
+}
+
+// skip n unsigned integers of CPU PRNG (next initialized GPU instance 0 continues from the new position)
+void
+HGPU_PRNG_skip(HGPU_PRNG* prng,u64_T n){
+    if ((!prng) || (!prng->prng)) {
+        HGPU_error_note(HGPU_ERROR_BAD_PRNG,"PRNG is not initialized");
+        return;
+    }
+    if (prng->prng->CPU_skip) {
+        (*prng->prng->CPU_skip)(prng->state,n);
+    } else if (prng->prng->CPU_produce_one_uint) {
+        // no jump-ahead for this PRNG: discard PRNs one by one
+        for (u64_T i=0; i<n; i++) (*prng->prng->CPU_produce_one_uint)(prng->state);
+    } else if (prng->prng->CPU_produce_one_double) {
+        for (u64_T i=0; i<n; i++) (*prng->prng->CPU_produce_one_double)(prng->state);
+    } else
+        HGPU_error_note(HGPU_ERROR_BAD_PRNG_SKIP,"PRNG skip-ahead is not supported");
+}
+
+static void
+HGPU_PRNG_GPU_skip_substreams(HGPU_GPU_context* context,HGPU_PRNG* prng,u64_T n,u64_T stride){
+    unsigned int kernel_id = prng->parameters->id_kernel_skip;
+    cl_ulong skip_n      = n;
+    cl_ulong skip_stride = stride;
+    HGPU_GPU_context_kernel_bind_constant_by_argument_id(context,kernel_id,&skip_n,sizeof(skip_n),1);
+    HGPU_GPU_context_kernel_bind_constant_by_argument_id(context,kernel_id,&skip_stride,sizeof(skip_stride),2);
+    HGPU_GPU_context_kernel_run(context,kernel_id);
+}
+
+// skip n unsigned integers of every GPU instance
+void
+HGPU_PRNG_GPU_skip(HGPU_GPU_context* context,HGPU_PRNG* prng,u64_T n){
+    if (!context) {
+        HGPU_GPU_error_note(HGPU_ERROR_BAD_CONTEXT,"context is not initialized");
+        return;
+    }
+    if (!prng) {
+        HGPU_GPU_error_note(HGPU_ERROR_BAD_PRNG,"PRNG is not initialized");
+        return;
+    }
+    if (prng->parameters->id_kernel_skip>=HGPU_GPU_MAX_KERNELS) {
+        HGPU_GPU_error_note(HGPU_ERROR_BAD_PRNG_SKIP,"PRNG skip-ahead on GPU is not supported");
+        return;
+    }
+    HGPU_PRNG_GPU_skip_substreams(context,prng,n,0);
+}
+
 double
 HGPU_PRNG_produce_CPU_float_one(HGPU_PRNG* prng,unsigned int){
     return (double) ((float) prng->prng->CPU_produce_one_double(prng->state));
@@ -557,6 +1190,116 @@ HGPU_PRNG_produce_CPU_one(HGPU_PRNG* prng){
     return result;
 }
 
+// CPU reference of prngcl_distribution.cl (T is float or double like hgpu_float in OpenCL program)
+template <typename T> static void
+HGPU_PRNG_box_muller(T u1,T u2,T* result){
+    T r = sqrt(((T) -2.0) * log(MAX(u1,(T) HGPU_PRNG_DISTRIBUTION_MIN_FP)));
+    T t = ((T) HGPU_PRNG_DISTRIBUTION_2PI) * u2;
+    result[0] = r * cos(t);
+    result[1] = r * sin(t);
+}
+
+template <typename T> static unsigned int
+HGPU_PRNG_polar_candidate(HGPU_PRNG_parameters* parameters,T u1,T u2,T* values){
+    T v1 = u1 * ((T) 2.0) - ((T) 1.0);
+    T v2 = u2 * ((T) 2.0) - ((T) 1.0);
+    T s  = v1 * v1 + v2 * v2;
+    if ((s <= (T) 0.0) || (s >= (T) 1.0)) return 0;
+    T f  = sqrt(((T) -2.0) * log(s) / s);
+    values[0] = ((T) parameters->normal_mean) + ((T) parameters->normal_sigma) * (v1 * f);
+    values[1] = ((T) parameters->normal_mean) + ((T) parameters->normal_sigma) * (v2 * f);
+    return 2;
+}
+
+template <typename T> static T
+HGPU_PRNG_poisson_inversion(const HGPU_PRNG_distribution_constants* constants,T u){
+    T k = (T) 0.0;
+    T p = (T) constants->exp_lambda;
+    T F = p;
+    for (unsigned int n=1; (n<HGPU_PRNG_POISSON_MAX_K) && (p > (T) 0.0) && (u > F); n++) {   // the same as on GPU: stop when p underflows
+        k = k + ((T) 1.0);
+        p = p * ((T) constants->lambda) / ((T) n);
+        F = F + p;
+    }
+    return k;
+}
+
+template <typename T> static unsigned int
+HGPU_PRNG_poisson_ptrs_candidate(const HGPU_PRNG_distribution_constants* constants,T u,T v,T* values){
+    T U  = u - ((T) 0.5);
+    T us = ((T) 0.5) - fabs(U);
+    if (us <= (T) 0.0) return 0;
+    T k  = floor((((T) 2.0) * ((T) constants->ptrs_a) / us + ((T) constants->ptrs_b)) * U + ((T) constants->lambda) + ((T) 0.43));
+    values[0] = k;
+    if ((us >= (T) 0.07) && (v <= (T) constants->ptrs_vr)) return 1;
+    if ((k < (T) 0.0) || ((us < (T) 0.013) && (v > us))) return 0;
+    if ((log(v) + ((T) constants->ptrs_log_inv_alpha) - log(((T) constants->ptrs_a) / (us * us) + ((T) constants->ptrs_b))) <=
+        (k * ((T) constants->log_lambda) - ((T) constants->lambda) - lgamma(k + ((T) 1.0)))) return 1;
+    return 0;
+}
+
+template <typename T> static unsigned int
+HGPU_PRNG_gamma_candidate(const HGPU_PRNG_distribution_constants* constants,T x,T u,T* values){
+    T v  = ((T) 1.0) + ((T) constants->gamma_c) * x;
+    if (v <= (T) 0.0) return 0;
+    v = v * v * v;
+    T x2 = x * x;
+    T g  = ((T) 0.5) * x2 + ((T) constants->gamma_d) * (((T) 1.0) - v + log(v));
+    values[0] = ((T) constants->gamma_d) * v * ((T) constants->gamma_scale);
+    if (constants->gamma_boost) {
+        if (!(log(u) < g)) return 0;
+        values[0] *= pow(u * exp(-g),(T) constants->gamma_boost);
+        return 1;
+    }
+    if (u < ((T) 1.0) - ((T) 0.0331) * (x2 * x2)) return 1;
+    return (log(u) < g) ? 1 : 0;
+}
+
+// PRNs in distribution from four uniform PRNs (like prng_next_output_float4 or prng_candidates_float4), returns number of produced PRNs
+template <typename T> static unsigned int
+HGPU_PRNG_distribution_candidates4(HGPU_PRNG* prng,const HGPU_PRNG_distribution_constants* constants,const double* rnd,T* values){
+    HGPU_PRNG_parameters* parameters = prng->parameters;
+    T u[4];
+    T x[2];
+    unsigned int n = 0;
+    for (unsigned int j=0; j<4; j++) u[j] = (T) rnd[j];
+
+    switch (parameters->distribution) {
+        case HGPU_PRNG_distribution_normal:
+        case HGPU_PRNG_distribution_lognormal:
+            HGPU_PRNG_box_muller<T>(u[0],u[1],&values[0]);
+            HGPU_PRNG_box_muller<T>(u[2],u[3],&values[2]);
+            for (n=0; n<4; n++) {
+                values[n] = ((T) parameters->normal_mean) + ((T) parameters->normal_sigma) * values[n];
+                if (parameters->distribution==HGPU_PRNG_distribution_lognormal) values[n] = exp(values[n]);
+            }
+            break;
+        case HGPU_PRNG_distribution_normal_polar:
+            n += HGPU_PRNG_polar_candidate<T>(parameters,u[0],u[1],values + n);
+            n += HGPU_PRNG_polar_candidate<T>(parameters,u[2],u[3],values + n);
+            break;
+        case HGPU_PRNG_distribution_exponential:
+            for (n=0; n<4; n++) values[n] = -log(MAX(u[n],(T) HGPU_PRNG_DISTRIBUTION_MIN_FP)) / ((T) constants->lambda);
+            break;
+        case HGPU_PRNG_distribution_poisson:
+            if (constants->poisson_large) {
+                n += HGPU_PRNG_poisson_ptrs_candidate<T>(constants,u[0],u[1],values + n);
+                n += HGPU_PRNG_poisson_ptrs_candidate<T>(constants,u[2],u[3],values + n);
+            } else
+                for (n=0; n<4; n++) values[n] = HGPU_PRNG_poisson_inversion<T>(constants,u[n]);
+            break;
+        case HGPU_PRNG_distribution_gamma:
+            HGPU_PRNG_box_muller<T>(u[0],u[1],x);
+            n += HGPU_PRNG_gamma_candidate<T>(constants,x[0],u[2],values + n);
+            n += HGPU_PRNG_gamma_candidate<T>(constants,x[1],u[3],values + n);
+            break;
+        default:
+            for (n=0; n<4; n++) values[n] = u[n];
+            break;
+    }
+    return n;
+}
+
 void
 HGPU_PRNG_produce_CPU(HGPU_PRNG* prng,double** randoms_CPU,unsigned int number_of_prns){
     if ((!prng) || (!randoms_CPU) || (!number_of_prns)) return;
@@ -592,10 +1335,136 @@ HGPU_PRNG_produce_CPU(HGPU_PRNG* prng,double** randoms_CPU,unsigned int number_o
         prng_produce_one = &HGPU_PRNG_produce_CPU_float_one;
     }
 
-    if (prng_produce_one)
+    if ((prng_produce_one) && (prng->parameters->distribution==HGPU_PRNG_distribution_uniform))
         for (unsigned int i=0; i<number_of_prns; i++)
             result[i] = (*prng_produce_one)(prng,prng_drop);
 
+    // non-uniform PRNs are produced from uniform ones by fours (like hgpu_float4 on GPU),
+    // all accepted PRNs of rejection sampling are used in order (like in prng_produce_float4)
+    if ((prng_produce_one) && (prng->parameters->distribution!=HGPU_PRNG_distribution_uniform)) {
+        HGPU_PRNG_distribution_constants constants = HGPU_PRNG_distribution_constants_get(prng);
+        unsigned int i = 0;
+        while (i<number_of_prns) {
+            double rnd[4];
+            double values[4];
+            float  values_float[4];
+            unsigned int n = 0;
+            for (unsigned int j=0; j<4; j++) rnd[j] = (*prng_produce_one)(prng,prng_drop);
+            if (prng->parameters->precision==HGPU_precision_double)
+                n = HGPU_PRNG_distribution_candidates4<double>(prng,&constants,rnd,values);
+            else {
+                n = HGPU_PRNG_distribution_candidates4<float>(prng,&constants,rnd,values_float);
+                for (unsigned int j=0; j<n; j++) values[j] = (double) values_float[j];
+            }
+            for (unsigned int j=0; (j<n) && (i<number_of_prns); j++) result[i++] = values[j];
+        }
+    }
+
+    (*randoms_CPU) = result;
+}
+
+// index of PRN in buffer of PRNs with (lanes) PRNs per element (lanes=4 for hgpu_float4 and uint4, lanes=2 for ulong2):
+// work-item (instance) writes its sample to element instance+sample*instances, while PRNs are numbered instance by instance
+// (lanes of one element are consecutive PRNs, or separate substreams of one instance for PRNGs with one PRN per step)
+static void
+HGPU_PRNG_GPU_buffer_index(HGPU_PRNG* prng,unsigned int index,unsigned int lanes,unsigned int* element,unsigned int* lane){
+    unsigned int offset  = prng->parameters->instances;
+    unsigned int samples = MAX(1,prng->parameters->samples);
+    unsigned int index_s = 0;
+    unsigned int index_h = 0;
+    unsigned int index_o = 0;
+    if (HGPU_PRNG_get_output_type_values(prng) == 1) {
+        index_s = (index / samples) % lanes;
+        index_h = index % samples;
+        index_o = (index / (lanes * samples));
+    } else {
+        index_s = (index % lanes);
+        index_h = ((index / lanes) % samples);
+        index_o = ((index / lanes) / samples);
+    }
+    (*element) = index_o + offset*index_h;
+    (*lane)    = index_s;
+}
+
+// de-interleave PRNs [first,first+count) of mapped randoms buffer into sequential order (see HGPU_PRNG_GPU_buffer_index):
+// buffer is transposed by HGPU_PRNG_COPY_BLOCK x HGPU_PRNG_COPY_BLOCK tiles of (samples x streams), so rows of
+// both source and destination stay in cache; stream is instance (or its lane for PRNGs with one PRN per step)
+template <typename T,typename R>
+static void
+HGPU_PRNG_GPU_copy_transpose(HGPU_PRNG* prng,const T* randoms,unsigned int lanes,R* dst,size_t first,size_t count){
+    size_t instances  = prng->parameters->instances;
+    size_t samples    = MAX(1,prng->parameters->samples);
+    size_t last       = first + count;
+    bool   substreams = (HGPU_PRNG_get_output_type_values(prng) == 1);
+    size_t stream_length = (substreams) ? samples : (samples * lanes);   // PRNs of one stream
+    size_t stream_first  = first / stream_length;
+    size_t stream_last   = MIN(instances * ((substreams) ? lanes : 1),1 + (last - 1) / stream_length);
+
+    for (size_t v0=stream_first; v0<stream_last; v0+=HGPU_PRNG_COPY_BLOCK) {
+        size_t v1 = MIN(v0 + HGPU_PRNG_COPY_BLOCK,stream_last);
+        for (size_t s0=0; s0<samples; s0+=HGPU_PRNG_COPY_BLOCK) {
+            size_t s1 = MIN(s0 + HGPU_PRNG_COPY_BLOCK,samples);
+            if (((v1 - 1) * stream_length + s1 * ((substreams) ? 1 : lanes) <= first) ||
+                (v0 * stream_length + s0 * ((substreams) ? 1 : lanes) >= last)) continue;
+            for (size_t s=s0; s<s1; s++) {
+                const T* row = randoms + s * instances;
+                if (substreams) {
+                    for (size_t v=v0; v<v1; v++) {
+                        size_t index = v * stream_length + s;
+                        if ((index>=first) && (index<last)) dst[index - first] = (R) row[v / lanes].s[v % lanes];
+                    }
+                } else {
+                    for (size_t v=v0; v<v1; v++)
+                        for (size_t l=0; l<lanes; l++) {
+                            size_t index = v * stream_length + s * lanes + l;
+                            if ((index>=first) && (index<last)) dst[index - first] = (R) row[v].s[l];
+                        }
+                }
+            }
+        }
+    }
+}
+
+// CPU reference of raw integer output: 64-bit PRNs are made of (high,low) pairs of 32-bit PRNs, which are
+// (x,y) and (z,w) components of the same uint4 on GPU (the pair is split between instances for PRNGs with uint output type)
+void
+HGPU_PRNG_produce_CPU_integer(HGPU_PRNG* prng,u64_T** randoms_CPU,unsigned int number_of_prns){
+    if ((!prng) || (!randoms_CPU) || (!number_of_prns)) return;
+    if (!prng->prng->CPU_produce_one_uint) {
+        HGPU_error_note(HGPU_ERROR_BAD_PRNG_OUTPUT,"integer output is supported only by PRNGs with integer output type");
+        return;
+    }
+    u64_T* result = (*randoms_CPU);
+    if (!result) {
+        result = (u64_T*) calloc(number_of_prns,sizeof(u64_T));
+        if (!result)
+            HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for PRNG_CPU_output");
+    }
+
+    if (prng->parameters->output_format==HGPU_PRNG_output_format_uint64) {
+        unsigned int offset   = MAX(1,prng->parameters->instances);
+        bool uint_output      = (HGPU_PRNG_get_output_type_values(prng) == 1);
+        unsigned int number32 = (uint_output) ? (2 * number_of_prns + 4 * offset) : (2 * number_of_prns);
+        u64_T* randoms32 = (u64_T*) calloc(number32,sizeof(u64_T));
+        if (!randoms32)
+            HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for PRNG_CPU_output");
+        for (unsigned int i=0; i<number32; i++)
+            randoms32[i] = (*prng->prng->CPU_produce_one_uint)(prng->state);
+        for (unsigned int i=0; i<number_of_prns; i++) {
+            // index of high 32-bit PRN of pair and distance to low one
+            unsigned int index_high = 2 * i;
+            unsigned int index_step = 1;
+            if (uint_output) {
+                index_high = (i / (2 * offset)) * 4 * offset + ((i / offset) & 1) * 2 * offset + (i % offset);
+                index_step = offset;
+            }
+            result[i] = (randoms32[index_high] << 32) | randoms32[index_high + index_step];
+        }
+        free(randoms32);
+    } else
+        for (unsigned int i=0; i<number_of_prns; i++)
+            result[i] = (*prng->prng->CPU_produce_one_uint)(prng->state);
+
     (*randoms_CPU) = result;
 }
 
@@ -613,6 +1482,23 @@ HGPU_PRNG_make_header(HGPU_PRNG* prng){
     j += sprintf_s(buffer+j,HGPU_GPU_MAX_OPTIONS_LENGTH-j," PRNG randseries             : %u\n",prng->parameters->randseries);
     j += sprintf_s(buffer+j,HGPU_GPU_MAX_OPTIONS_LENGTH-j," PRNG instances              : %u\n",prng->parameters->instances);
     j += sprintf_s(buffer+j,HGPU_GPU_MAX_OPTIONS_LENGTH-j," PRNG samples                : %u\n",prng->parameters->samples);
+    if (prng->parameters->output_format!=HGPU_PRNG_output_format_float)
+        j += sprintf_s(buffer+j,HGPU_GPU_MAX_OPTIONS_LENGTH-j," PRNG output                 : %s\n",HGPU_convert_output_format_to_str(prng->parameters->output_format));
+    HGPU_PRNG_distribution distribution = prng->parameters->distribution;
+    if (prng->parameters->output_format!=HGPU_PRNG_output_format_float) distribution = HGPU_PRNG_distribution_uniform;
+    if (distribution!=HGPU_PRNG_distribution_uniform)
+        j += sprintf_s(buffer+j,HGPU_GPU_MAX_OPTIONS_LENGTH-j," PRNG distribution           : %s\n",HGPU_convert_distribution_to_str(distribution));
+    if ((distribution==HGPU_PRNG_distribution_normal) || (distribution==HGPU_PRNG_distribution_normal_polar) ||
+        (distribution==HGPU_PRNG_distribution_lognormal)) {
+        j += sprintf_s(buffer+j,HGPU_GPU_MAX_OPTIONS_LENGTH-j," PRNG normal mean            : %e\n",prng->parameters->normal_mean);
+        j += sprintf_s(buffer+j,HGPU_GPU_MAX_OPTIONS_LENGTH-j," PRNG normal sigma           : %e\n",prng->parameters->normal_sigma);
+    }
+    if ((distribution==HGPU_PRNG_distribution_exponential) || (distribution==HGPU_PRNG_distribution_poisson))
+        j += sprintf_s(buffer+j,HGPU_GPU_MAX_OPTIONS_LENGTH-j," PRNG lambda                 : %e\n",prng->parameters->lambda);
+    if (distribution==HGPU_PRNG_distribution_gamma) {
+        j += sprintf_s(buffer+j,HGPU_GPU_MAX_OPTIONS_LENGTH-j," PRNG Gamma shape            : %e\n",prng->parameters->gamma_shape);
+        j += sprintf_s(buffer+j,HGPU_GPU_MAX_OPTIONS_LENGTH-j," PRNG Gamma scale            : %e\n",prng->parameters->gamma_scale);
+    }
     j += sprintf_s(buffer+j,HGPU_GPU_MAX_OPTIONS_LENGTH-j," ***************************************************\n");
 
     size_t result_length = strlen(buffer) + 1;
@@ -625,37 +1511,90 @@ double
 HGPU_PRNG_GPU_get_from_buffer(HGPU_GPU_context* context,HGPU_PRNG* prng,unsigned int index){
     double result = 0.0;
     if ((!context) || (!prng)) return result;
+    if (prng->parameters->output_format!=HGPU_PRNG_output_format_float)
+        return (double) HGPU_PRNG_GPU_get_uint_from_buffer(context,prng,index);
     void* results_ptr = HGPU_GPU_context_buffer_get_mapped(context,prng->parameters->id_buffer_randoms);
     cl_float4*  pointer_to_randoms = NULL;
     cl_double4* pointer_to_randoms_double = NULL;
-    unsigned int output_type_vals = HGPU_PRNG_get_output_type_values(prng);
-    unsigned int index_s = 0;
-    unsigned int index_h = 0;
-    unsigned int index_o = 0;
+    unsigned int element = 0;
+    unsigned int lane    = 0;
     if (prng->parameters->precision==HGPU_precision_double)
         pointer_to_randoms_double = (cl_double4*) results_ptr;
     else
         pointer_to_randoms        = (cl_float4*) results_ptr;
     if ((pointer_to_randoms) || (pointer_to_randoms_double)) {
-        unsigned int offset = prng->parameters->instances;
-        if (output_type_vals == 1) {
-            index_s = (index / offset) & 3;
-            index_h = index % offset;
-            index_o = (index / (4 * offset));
-        }
-        if (output_type_vals == 4) {
-            index_s = (index & 3);
-            index_h = ((index >> 2) % offset) ;
-            index_o = ((index >> 2) / offset);
-        }
+        HGPU_PRNG_GPU_buffer_index(prng,index,4,&element,&lane);
         if (prng->parameters->precision==HGPU_precision_double)
-            result = pointer_to_randoms_double[index_o + offset*index_h].s[index_s];
+            result = pointer_to_randoms_double[element].s[lane];
         else
-            result = pointer_to_randoms[index_o + offset*index_h].s[index_s];
+            result = pointer_to_randoms[element].s[lane];
     }
     return result;
 }
 
+u64_T
+HGPU_PRNG_GPU_get_uint_from_buffer(HGPU_GPU_context* context,HGPU_PRNG* prng,unsigned int index){
+    u64_T result = 0;
+    if ((!context) || (!prng)) return result;
+    if (prng->parameters->output_format==HGPU_PRNG_output_format_float)
+        return (u64_T) HGPU_PRNG_GPU_get_from_buffer(context,prng,index);
+    void* results_ptr = HGPU_GPU_context_buffer_get_mapped(context,prng->parameters->id_buffer_randoms);
+    unsigned int element = 0;
+    unsigned int lane    = 0;
+    if (results_ptr) {
+        if (prng->parameters->output_format==HGPU_PRNG_output_format_uint64) {
+            HGPU_PRNG_GPU_buffer_index(prng,index,2,&element,&lane);
+            result = ((cl_ulong2*) results_ptr)[element].s[lane];
+        } else {
+            HGPU_PRNG_GPU_buffer_index(prng,index,4,&element,&lane);
+            result = ((cl_uint4*)  results_ptr)[element].s[lane];
+        }
+    }
+    return result;
+}
+
+// number of PRNs in randoms buffer
+static size_t
+HGPU_PRNG_GPU_get_buffer_prns(HGPU_PRNG* prng,unsigned int* lanes){
+    (*lanes) = (prng->parameters->output_format==HGPU_PRNG_output_format_uint64) ? 2 : 4;
+    return ((size_t) prng->parameters->instances) * prng->parameters->samples * (*lanes);
+}
+
+template <typename R>
+static size_t
+HGPU_PRNG_GPU_copy(HGPU_GPU_context* context,HGPU_PRNG* prng,R* dst,size_t first,size_t count){
+    unsigned int lanes = 4;
+    size_t number_of_prns = HGPU_PRNG_GPU_get_buffer_prns(prng,&lanes);
+    if (first>=number_of_prns) return 0;
+    count = MIN(count,number_of_prns - first);
+    void* results_ptr = HGPU_GPU_context_buffer_get_mapped(context,prng->parameters->id_buffer_randoms);
+    if ((!results_ptr) || (!count)) return 0;
+    if (prng->parameters->output_format==HGPU_PRNG_output_format_uint64)
+        HGPU_PRNG_GPU_copy_transpose(prng,(cl_ulong2*)  results_ptr,lanes,dst,first,count);
+    else if (prng->parameters->output_format==HGPU_PRNG_output_format_uint32)
+        HGPU_PRNG_GPU_copy_transpose(prng,(cl_uint4*)   results_ptr,lanes,dst,first,count);
+    else if (prng->parameters->precision==HGPU_precision_double)
+        HGPU_PRNG_GPU_copy_transpose(prng,(cl_double4*) results_ptr,lanes,dst,first,count);
+    else
+        HGPU_PRNG_GPU_copy_transpose(prng,(cl_float4*)  results_ptr,lanes,dst,first,count);
+    return count;
+}
+
+// copy PRNs [first,first+count) of randoms buffer to host in sequential order (the same as HGPU_PRNG_GPU_get_from_buffer),
+// buffer is mapped once; returns number of copied PRNs
+size_t
+HGPU_PRNG_GPU_copy_to_host(HGPU_GPU_context* context,HGPU_PRNG* prng,double* dst,size_t first,size_t count){
+    if ((!context) || (!prng) || (!dst)) return 0;
+    return HGPU_PRNG_GPU_copy<double>(context,prng,dst,first,count);
+}
+
+// copy raw integer PRNs [first,first+count) of randoms buffer to host in sequential order
+size_t
+HGPU_PRNG_GPU_copy_uint_to_host(HGPU_GPU_context* context,HGPU_PRNG* prng,u64_T* dst,size_t first,size_t count){
+    if ((!context) || (!prng) || (!dst)) return 0;
+    return HGPU_PRNG_GPU_copy<u64_T>(context,prng,dst,first,count);
+}
+
 unsigned int
 HGPU_PRNG_get_output_type_values(HGPU_PRNG* prng){
     unsigned int result = 1;
@@ -672,6 +1611,15 @@ HGPU_PRNG_get_output_type_values(HGPU_PRNG* prng){
     return result;
 }
 
+// number of PRNs per sample of one instance in randoms buffer
+unsigned int
+HGPU_PRNG_get_output_values(HGPU_PRNG* prng){
+    unsigned int result = HGPU_PRNG_get_output_type_values(prng);
+    if ((prng->parameters->output_format==HGPU_PRNG_output_format_uint64) && (result == 4))
+        result = 2;
+    return result;
+}
+
 void
 HGPU_PRNG_write_results(HGPU_GPU_context* context,HGPU_PRNG* prng,const char* file_path,const char* file_name){
     FILE *stream;
@@ -684,10 +1632,23 @@ HGPU_PRNG_write_results(HGPU_GPU_context* context,HGPU_PRNG* prng,const char* fi
     if(stream){
         char* header = HGPU_PRNG_make_header(prng);
         fprintf(stream,"%s",header);
-        unsigned int output_type_vals = HGPU_PRNG_get_output_type_values(prng);
+        unsigned int output_type_vals = HGPU_PRNG_get_output_values(prng);
         unsigned int number_of_prns = prng->parameters->samples * output_type_vals;
-        for (unsigned int i=0; i<number_of_prns; i++)
-            fprintf(stream,"[%5u]   % .20e\n",i,HGPU_PRNG_GPU_get_from_buffer(context,prng,i));
+        if (prng->parameters->output_format!=HGPU_PRNG_output_format_float) {
+            u64_T* randoms = (u64_T*) calloc(MAX(1,number_of_prns),sizeof(u64_T));
+            if (!randoms) HGPU_error(HGPU_ERROR_NO_MEMORY);
+            HGPU_PRNG_GPU_copy_uint_to_host(context,prng,randoms,0,number_of_prns);
+            for (unsigned int i=0; i<number_of_prns; i++)
+                fprintf(stream,"[%5u]   %20llu\n",i,(llu_T) randoms[i]);
+            free(randoms);
+        } else {
+            double* randoms = (double*) calloc(MAX(1,number_of_prns),sizeof(double));
+            if (!randoms) HGPU_error(HGPU_ERROR_NO_MEMORY);
+            HGPU_PRNG_GPU_copy_to_host(context,prng,randoms,0,number_of_prns);
+            for (unsigned int i=0; i<number_of_prns; i++)
+                fprintf(stream,"[%5u]   % .20e\n",i,randoms[i]);
+            free(randoms);
+        }
         if (fclose(stream)) HGPU_error_note(HGPU_ERROR_FILE_NOT_CLOSED,"the file was not closed");
         free(header);
     }
@@ -704,21 +1665,352 @@ HGPU_PRNG_write_output_text(HGPU_GPU_context* context,HGPU_PRNG* prng,const char
 
     fopen_s(&stream,buffer,"w+");
     if(stream){
-        unsigned int output_type_vals = HGPU_PRNG_get_output_type_values(prng);
-        unsigned int number_of_prns = prng->parameters->instances * prng->parameters->samples * output_type_vals;
-        for (unsigned int i=0; i<(number_of_prns>>2); i++){
-            for (unsigned int j=0; j<MIN(4,(number_of_prns-i*4)); j++)
-                fprintf(stream,"% .20e ",HGPU_PRNG_GPU_get_from_buffer(context,prng,i*4+j));
-            fprintf(stream,"\n");
+        unsigned int output_type_vals = HGPU_PRNG_get_output_values(prng);
+        size_t number_of_prns = ((size_t) prng->parameters->instances) * prng->parameters->samples * output_type_vals;
+        number_of_prns -= number_of_prns & 3;
+        bool integer_output = (prng->parameters->output_format!=HGPU_PRNG_output_format_float);
+        // PRNs are copied to host by chunks of HGPU_PRNG_COPY_CHUNK (multiple of 4, i.e. of line)
+        size_t chunk = MIN(number_of_prns,(size_t) HGPU_PRNG_COPY_CHUNK);
+        u64_T*  randoms_uint = NULL;
+        double* randoms      = NULL;
+        if (integer_output)
+            randoms_uint = (u64_T*)  calloc(MAX(1,chunk),sizeof(u64_T));
+        else
+            randoms      = (double*) calloc(MAX(1,chunk),sizeof(double));
+        if ((!randoms_uint) && (!randoms)) HGPU_error(HGPU_ERROR_NO_MEMORY);
+        for (size_t first=0; first<number_of_prns; first+=chunk){
+            size_t count = MIN(chunk,number_of_prns - first);
+            if (integer_output)
+                HGPU_PRNG_GPU_copy_uint_to_host(context,prng,randoms_uint,first,count);
+            else
+                HGPU_PRNG_GPU_copy_to_host(context,prng,randoms,first,count);
+            for (size_t i=0; i<count; i+=4){
+                if (integer_output)
+                    fprintf(stream,"%20llu %20llu %20llu %20llu \n",(llu_T) randoms_uint[i],(llu_T) randoms_uint[i+1],
+                            (llu_T) randoms_uint[i+2],(llu_T) randoms_uint[i+3]);
+                else
+                    fprintf(stream,"% .20e % .20e % .20e % .20e \n",randoms[i],randoms[i+1],randoms[i+2],randoms[i+3]);
+            }
         }
+        free(randoms_uint);
+        free(randoms);
         if (fclose(stream)) HGPU_error_note(HGPU_ERROR_FILE_NOT_CLOSED,"the file was not closed");
     }
     free(buffer);
 }
 
+// write bytes of host memory to stream by chunks of HGPU_PRNG_BINARY_CHUNK, returns number of written bytes
+static u64_T
+HGPU_PRNG_write_binary_chunks(FILE* stream,const unsigned char* randoms,u64_T bytes){
+    u64_T result = 0;
+    while (result<bytes) {
+        size_t chunk   = (size_t) MIN((u64_T) HGPU_PRNG_BINARY_CHUNK,bytes - result);
+        size_t written = fwrite(randoms + result,sizeof(unsigned char),chunk,stream);
+        result += written;
+        if (written<chunk) break;
+    }
+    return result;
+}
+
+// number of bytes of PRNs in randoms buffer (without alignment tail)
+static u64_T
+HGPU_PRNG_GPU_get_buffer_bytes(HGPU_GPU_context* context,unsigned int randoms_id,HGPU_PRNG* prng){
+    if ((!context) || (randoms_id>=HGPU_GPU_MAX_BUFFERS)) return 0;
+    HGPU_GPU_buffer* buffer = HGPU_GPU_buffer_get_by_index(context->buffer,randoms_id);
+    if (!buffer) return 0;
+    return ((u64_T) prng->parameters->instances) * prng->parameters->samples * buffer->sizeof_element;
+}
+
+// write at most max_bytes of randoms buffer (all of it if max_bytes=0) to stream as is, returns number of written bytes:
+// PRNs of all instances are interleaved in order of production (sample by sample), buffer is unmapped afterwards
+static u64_T
+HGPU_PRNG_write_binary_buffer(HGPU_GPU_context* context,HGPU_PRNG* prng,FILE* stream,u64_T max_bytes){
+    u64_T result = 0;
+    unsigned int randoms_id = prng->parameters->id_buffer_randoms;
+    u64_T bytes = HGPU_PRNG_GPU_get_buffer_bytes(context,randoms_id,prng);
+    if (!bytes) {
+        HGPU_GPU_error_note(HGPU_ERROR_BAD_BUFFER,"PRNG has no randoms buffer");
+        return result;
+    }
+    if (max_bytes) bytes = MIN(bytes,max_bytes);
+    const unsigned char* randoms = (const unsigned char*) HGPU_GPU_context_buffer_get_mapped(context,randoms_id);
+    if (!randoms) return result;
+    result = HGPU_PRNG_write_binary_chunks(stream,randoms,bytes);
+    HGPU_GPU_context_buffer_unmap(context,randoms_id,(void*) randoms);
+    return result;
+}
+
+// bind randoms buffer to production kernel (it follows seed table, if any)
+unsigned int
+HGPU_PRNG_kernel_bind_randoms(HGPU_GPU_context* context,HGPU_PRNG* prng,unsigned int randoms_id){
+    unsigned int argument_id = (prng->parameters->id_buffer_seeds<HGPU_GPU_MAX_BUFFERS) ? 1 : 0;
+    return HGPU_GPU_context_kernel_bind_buffer_by_argument_id(context,prng->parameters->id_kernel_produce,randoms_id,argument_id);
+}
+
+// write PRNs of randoms buffer to binary file in native format of buffer:
+// float32 or float64 (PRNG_PRECISION) for floating point output, uint32 or uint64 for raw integer output (PRNG_OUTPUT)
+void
+HGPU_PRNG_write_output_binary(HGPU_GPU_context* context,HGPU_PRNG* prng,const char* file_path,const char* file_name){
+    FILE *stream;
+    if ((!context) || (!prng)) return;
+
+    char* buffer = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
+    if (!buffer) HGPU_error(HGPU_ERROR_NO_MEMORY);
+    HGPU_io_path_join_filename(&buffer,HGPU_FILENAME_MAX,file_path,file_name);
+
+    fopen_s(&stream,buffer,"wb");
+    if(stream){
+        HGPU_PRNG_write_binary_buffer(context,prng,stream,0);
+        if (fclose(stream)) HGPU_error_note(HGPU_ERROR_FILE_NOT_CLOSED,"the file was not closed");
+    } else
+        HGPU_error_note(HGPU_ERROR_FILE_NOT_FOUND,"error writting binary file");
+    free(buffer);
+}
+
+// produce PRNs and write them to binary stream (file or stdout) until bytes are written (endless if bytes=0)
+// or stream is closed; returns number of written bytes.
+// PRNs are double-buffered: device produces next batch into second randoms buffer while host writes current one
+u64_T
+HGPU_PRNG_write_output_binary_stream(HGPU_GPU_context* context,HGPU_PRNG* prng,FILE* stream,u64_T bytes){
+    u64_T result = 0;
+    if ((!context) || (!prng) || (!stream)) return result;
+    u64_T buffer_bytes = HGPU_PRNG_GPU_get_buffer_bytes(context,prng->parameters->id_buffer_randoms,prng);
+    if (!buffer_bytes) {
+        HGPU_GPU_error_note(HGPU_ERROR_BAD_BUFFER,"PRNG has no randoms buffer");
+        return result;
+    }
+#ifdef _WIN32
+    if (stream==stdout) _setmode(_fileno(stdout),_O_BINARY);
+#endif
+
+    if (!HGPU_PRNG_pipeline_init(context,prng,2)) return result;
+    while ((!bytes) || (result<bytes)) {
+        unsigned int randoms_id = HGPU_PRNG_pipeline_next(context,prng);
+        const unsigned char* randoms = (const unsigned char*) HGPU_GPU_context_buffer_get_mapped(context,randoms_id);
+        if (!randoms) break;
+        u64_T chunk_bytes = (bytes) ? MIN(buffer_bytes,bytes - result) : buffer_bytes;
+        u64_T written = HGPU_PRNG_write_binary_chunks(stream,randoms,chunk_bytes);
+        result += written;
+        if (written<chunk_bytes) break;
+    }
+    fflush(stream);
+    HGPU_PRNG_pipeline_release(context,prng);
+    return result;
+}
+
+// copy of PRNG with the same parameters and CPU state (without buffers and kernels);
+// clone is not seeded, so internal state of HGPU_PRNG_rand32bit is not changed
+static HGPU_PRNG*
+HGPU_PRNG_clone(HGPU_PRNG* prng){
+    HGPU_PRNG* result = HGPU_PRNG_alloc(prng->prng);
+    memcpy(result->state,prng->state,prng->prng->state_size);
+    HGPU_PRNG_parameters* parameters = result->parameters;
+    (*parameters) = (*prng->parameters);
+    parameters->id_buffer_input_seeds = HGPU_GPU_MAX_BUFFERS;
+    parameters->id_buffer_seeds       = HGPU_GPU_MAX_BUFFERS;
+    parameters->id_buffer_randoms     = HGPU_GPU_MAX_BUFFERS;
+    parameters->id_kernel_produce     = HGPU_GPU_MAX_KERNELS;
+    parameters->id_kernel_skip        = HGPU_GPU_MAX_KERNELS;
+    parameters->pipeline_depth        = 0;
+    return result;
+}
+
+// new PRNG for several devices (contexts): instances of prng (0 = sum of autoselected instances of devices) are split among devices;
+// prng is cloned (it is not changed and stays owned by caller)
+HGPU_PRNG_multi*
+HGPU_PRNG_multi_new(HGPU_GPU_context** contexts,HGPU_PRNG* prng){
+    unsigned int number_of_devices = HGPU_GPU_contexts_get_number(contexts);
+    if ((!number_of_devices) || (!prng)) {
+        HGPU_GPU_error_note(HGPU_ERROR_BAD_CONTEXT,"context is not initialized");
+        return NULL;
+    }
+    HGPU_PRNG_multi* result = (HGPU_PRNG_multi*) calloc(1,sizeof(HGPU_PRNG_multi));
+    if (!result) HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for PRNG");
+    result->prng              = HGPU_PRNG_clone(prng);
+    result->context           = contexts;
+    result->number_of_devices = number_of_devices;
+    result->prng_device       = (HGPU_PRNG**)    calloc(number_of_devices,sizeof(HGPU_PRNG*));
+    result->instances_first   = (unsigned int*)  calloc(number_of_devices,sizeof(unsigned int));
+    if ((!result->prng_device) || (!result->instances_first))
+        HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for PRNG");
+
+    // calulate instances
+    HGPU_PRNG_parameters* parameters = result->prng->parameters;
+    if (!parameters->instances) {
+        unsigned int instances = 0;
+        for (unsigned int i=0; i<number_of_devices; i++) instances += HGPU_GPU_device_get_max_memory_width(contexts[i]->device);
+        parameters->instances = instances;
+        parameters->samples   = 1 + (parameters->samples - 1) / parameters->instances;
+    }
+    return result;
+}
+
+// measure relative productivity of devices: every device runs the same batch of passes with equal number of instances
+// (devices are measured one by one, so the elapsed time of every device is not affected by the others;
+//  with profiling the mean execution time of produce kernel is used instead of the wall-clock time)
+static void
+HGPU_PRNG_multi_calibrate(HGPU_PRNG_multi* multi,double* productivity){
+    unsigned int number_of_devices = multi->number_of_devices;
+    unsigned int instances = MAX(1,multi->prng->parameters->instances / number_of_devices);
+    for (unsigned int i=0; i<number_of_devices; i++) {
+        HGPU_GPU_context* context = multi->context[i];
+        HGPU_PRNG* prng = HGPU_PRNG_clone(multi->prng);
+        HGPU_PRNG_set_instances(prng,instances);
+        HGPU_PRNG_init(context,prng);
+        unsigned int kernel_id = prng->parameters->id_kernel_produce;
+        HGPU_PRNG_produce(context,kernel_id); // warm-up
+
+        std::chrono::steady_clock::time_point time_start = std::chrono::steady_clock::now();
+        HGPU_GPU_context_kernel_run_batch(context,kernel_id,HGPU_PRNG_MULTI_CALIBRATION);
+        HGPU_GPU_context_queue_wait_for_finish(context);
+        double elapsed = HGPU_convert_s_to_ns(std::chrono::duration<double>(std::chrono::steady_clock::now() - time_start).count()) / HGPU_PRNG_MULTI_CALIBRATION;
+
+        HGPU_GPU_kernel* kernel = HGPU_GPU_kernel_get_by_index(context->kernel,kernel_id);
+        if (kernel && context->debug_flags.profiling) {
+            HGPU_timer_deviation elapsed_time = HGPU_GPU_kernel_get_time_execution(kernel);
+            if (elapsed_time.mean>0.0) elapsed = elapsed_time.mean;
+        }
+        productivity[i] = (elapsed>0.0) ? (((double) instances) * prng->parameters->samples / elapsed) : 0.0;
+        HGPU_PRNG_and_buffers_free(context,prng);
+    }
+}
+
+// initialize PRNG on all devices: instances are split proportionally to productivity of devices
+// (e.g. by HGPU_PRNG_benchmark; measured if productivity=NULL);
+// with PRNG_SUBSTREAM slices are consecutive parts of the same streams set as on single device
+// (stream is instance or its lane for PRNGs with one PRN per step, see skip kernels), otherwise every device is seeded independently
+// (with randseries+device_index, so the same randseries gives the same PRNs)
+void
+HGPU_PRNG_multi_init(HGPU_PRNG_multi* multi,const double* productivity){
+    if (!multi) return;
+    unsigned int number_of_devices = multi->number_of_devices;
+    unsigned int instances = multi->prng->parameters->instances;
+    if (instances<number_of_devices) {
+        HGPU_GPU_error_note(HGPU_ERROR_BAD_PRNG_INIT,"number of PRNG instances is less than number of devices");
+        return;
+    }
+    double* weight = (double*) calloc(number_of_devices,sizeof(double));
+    if (!weight) HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for PRNG");
+    if (productivity)
+        for (unsigned int i=0; i<number_of_devices; i++) weight[i] = productivity[i];
+    else
+        HGPU_PRNG_multi_calibrate(multi,weight);
+    double weight_total = 0.0;
+    for (unsigned int i=0; i<number_of_devices; i++) weight_total += MAX(0.0,weight[i]);
+
+    // every device gets at least one instance, the rest goes to the first (the best) device
+    unsigned int instances_rest = instances;
+    unsigned int* instances_device = (unsigned int*) calloc(number_of_devices,sizeof(unsigned int));
+    if (!instances_device) HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for PRNG");
+    for (unsigned int i=number_of_devices; i>1; i--) {
+        double share = (weight_total>0.0) ? (MAX(0.0,weight[i-1]) / weight_total) : (1.0 / number_of_devices);
+        instances_device[i-1] = MIN(instances_rest - (i-1),MAX(1,(unsigned int) (share * instances)));
+        instances_rest -= instances_device[i-1];
+    }
+    instances_device[0] = instances_rest;
+
+    unsigned int instances_first = 0;
+    u64_T streams_per_instance = (HGPU_PRNG_get_output_type_values(multi->prng)==1) ? 4 : 1;
+    for (unsigned int i=0; i<number_of_devices; i++) {
+        HGPU_PRNG* prng = HGPU_PRNG_clone(multi->prng);
+        HGPU_PRNG_set_instances(prng,instances_device[i]);
+        prng->parameters->instances_first = instances_first;
+        // PRNG without skip-ahead on GPU cannot be partitioned into slices of substreams
+        if ((!prng->parameters->substream) || (!prng->prng->skip_kernel))
+            HGPU_PRNG_set_randseries(prng,multi->prng->parameters->randseries + i);
+        HGPU_PRNG_init(multi->context[i],prng);
+        // every stream of slice is shifted by the streams of previous slices
+        if (prng->parameters->substream && instances_first && (prng->parameters->id_kernel_skip<HGPU_GPU_MAX_KERNELS))
+            HGPU_PRNG_GPU_skip(multi->context[i],prng,((u64_T) instances_first) * streams_per_instance * prng->parameters->substream);
+        multi->prng_device[i]     = prng;
+        multi->instances_first[i] = instances_first;
+        instances_first += instances_device[i];
+    }
+    free(instances_device);
+    free(weight);
+}
+
+// produce PRNs on all devices simultaneously
+void
+HGPU_PRNG_multi_produce(HGPU_PRNG_multi* multi){
+    if (!multi) return;
+    for (unsigned int i=0; i<multi->number_of_devices; i++) {
+        if (!multi->prng_device[i]) continue;
+        HGPU_GPU_context_kernel_run_async(multi->context[i],multi->prng_device[i]->parameters->id_kernel_produce);
+        HGPU_GPU_context_queue_flush(multi->context[i]);
+    }
+    for (unsigned int i=0; i<multi->number_of_devices; i++)
+        HGPU_GPU_context_queue_wait_for_finish(multi->context[i]);
+}
+
+// copy PRNs [first,first+count) of all devices: PRNs of device slices follow each other in order of instances
+template <typename R>
+static size_t
+HGPU_PRNG_multi_copy(HGPU_PRNG_multi* multi,R* dst,size_t first,size_t count){
+    size_t result = 0;
+    size_t device_first = 0;
+    for (unsigned int i=0; (i<multi->number_of_devices) && (result<count); i++) {
+        HGPU_PRNG* prng = multi->prng_device[i];
+        if (!prng) continue;
+        unsigned int lanes = 4;
+        size_t device_prns = HGPU_PRNG_GPU_get_buffer_prns(prng,&lanes);
+        if (first + result < device_first + device_prns)
+            result += HGPU_PRNG_GPU_copy(multi->context[i],prng,&dst[result],first + result - device_first,count - result);
+        device_first += device_prns;
+    }
+    return result;
+}
+
+size_t
+HGPU_PRNG_multi_copy_to_host(HGPU_PRNG_multi* multi,double* dst,size_t first,size_t count){
+    if ((!multi) || (!dst)) return 0;
+    return HGPU_PRNG_multi_copy<double>(multi,dst,first,count);
+}
+
+size_t
+HGPU_PRNG_multi_copy_uint_to_host(HGPU_PRNG_multi* multi,u64_T* dst,size_t first,size_t count){
+    if ((!multi) || (!dst)) return 0;
+    return HGPU_PRNG_multi_copy<u64_T>(multi,dst,first,count);
+}
+
+// release PRNG on all devices and its copy of master PRNG (contexts are not released)
+void
+HGPU_PRNG_multi_free(HGPU_PRNG_multi* multi){
+    if (!multi) return;
+    for (unsigned int i=0; i<multi->number_of_devices; i++)
+        if (multi->prng_device[i]) HGPU_PRNG_and_buffers_free(multi->context[i],multi->prng_device[i]);
+    HGPU_PRNG_free(multi->prng);
+    free(multi->prng_device);
+    free(multi->instances_first);
+    free(multi);
+}
+
 unsigned int
 HGPU_PRNG_test(HGPU_GPU_context* context,HGPU_parameter** parameters,const HGPU_PRNG_description* prng_descr,unsigned int randseries,
                HGPU_precision precision,unsigned int number,double test_value){
+    return HGPU_PRNG_test_distribution(context,parameters,prng_descr,randseries,precision,HGPU_PRNG_distribution_uniform,number,test_value);
+}
+
+// compare GPU output with CPU reference: uniform PRNs should coincide exactly,
+// non-uniform ones - within tolerance (OpenCL built-in math functions are not correctly rounded)
+static bool
+HGPU_PRNG_test_compare(HGPU_PRNG* prng,double value1,double value2){
+    if (prng->parameters->distribution==HGPU_PRNG_distribution_uniform) return (value1==value2);
+    double tolerance = (prng->parameters->precision==HGPU_precision_double) ? HGPU_PRNG_TEST_TOLERANCE_DOUBLE : HGPU_PRNG_TEST_TOLERANCE_SINGLE;
+    return (fabs(value1-value2) <= tolerance * MAX(1.0,fabs(value2)));
+}
+
+unsigned int
+HGPU_PRNG_test_distribution(HGPU_GPU_context* context,HGPU_parameter** parameters,const HGPU_PRNG_description* prng_descr,unsigned int randseries,
+               HGPU_precision precision,HGPU_PRNG_distribution distribution,unsigned int number,double test_value){
+    return HGPU_PRNG_test_distribution_with_parameter(context,parameters,prng_descr,randseries,precision,distribution,0.0,number,test_value);
+}
+
+// test non-uniform distribution with parameter: lambda for exponential and Poisson distributions, shape for Gamma distribution
+// (parameter<=0 - default one)
+unsigned int
+HGPU_PRNG_test_distribution_with_parameter(HGPU_GPU_context* context,HGPU_parameter** parameters,const HGPU_PRNG_description* prng_descr,unsigned int randseries,
+               HGPU_precision precision,HGPU_PRNG_distribution distribution,double distribution_parameter,unsigned int number,double test_value){
     unsigned int result = 0;
 
     HGPU_PRNG_set_default_precision(precision);
@@ -730,6 +2022,13 @@ HGPU_PRNG_test(HGPU_GPU_context* context,HGPU_parameter** parameters,const HGPU_
 
     HGPU_PRNG* prng = HGPU_PRNG_new(prng_descr);
     if (randseries) HGPU_PRNG_set_randseries(prng,randseries);
+    HGPU_PRNG_set_distribution(prng,distribution);
+    if (distribution_parameter>0.0) {
+        if (distribution==HGPU_PRNG_distribution_gamma)
+            HGPU_PRNG_set_gamma(prng,distribution_parameter,prng->parameters->gamma_scale);
+        else
+            HGPU_PRNG_set_lambda(prng,distribution_parameter);
+    }
     double* CPU_results = (double*) calloc(number+1,sizeof(double));
     if (!CPU_results)
         HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for results");
@@ -741,18 +2040,22 @@ HGPU_PRNG_test(HGPU_GPU_context* context,HGPU_parameter** parameters,const HGPU_
 
     HGPU_PRNG_produce(context,prng_id);
     unsigned int output_type_vals = HGPU_PRNG_get_output_type_values(prng);
-    unsigned int number_of_prns = prng->parameters->samples * output_type_vals;
+    unsigned int number_of_prns = MIN(number,prng->parameters->samples * output_type_vals);
+    double* GPU_results = (double*) calloc(number+1,sizeof(double));
+    if (!GPU_results)
+        HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for results");
+    HGPU_PRNG_GPU_copy_to_host(context,prng,GPU_results,0,number_of_prns);
     double GPU_prn, CPU_prn;
     for (unsigned int i=0; i<number_of_prns; ++i) {
         if (precision==HGPU_precision_single) {
-            GPU_prn = ((float) HGPU_PRNG_GPU_get_from_buffer(context,prng,i));
+            GPU_prn = ((float) GPU_results[i]);
             CPU_prn = ((float) CPU_results[i]);
         } else {
-            GPU_prn = HGPU_PRNG_GPU_get_from_buffer(context,prng,i);
+            GPU_prn = GPU_results[i];
             CPU_prn = CPU_results[i];
         }
         
-        if (GPU_prn!=CPU_prn) {
+        if (!HGPU_PRNG_test_compare(prng,GPU_prn,CPU_prn)) {
             printf("[%u]:\t  GPU: % .20e      CPU: % .20e     difference: % e\n",(unsigned int) i,GPU_prn,CPU_prn,(GPU_prn-CPU_prn));
             result++;
         }
@@ -761,23 +2064,153 @@ HGPU_PRNG_test(HGPU_GPU_context* context,HGPU_parameter** parameters,const HGPU_
     double test_value_norm = test_value;
     if (prng->parameters->precision==HGPU_precision_single) test_value_norm = (double) ((float) test_value);
 
-    if (test_value_norm!=CPU_value) {
+    if (!HGPU_PRNG_test_compare(prng,CPU_value,test_value_norm)) {
         printf("Expected: % .20e    Generated: % .20e    Difference: % e\n",test_value_norm,CPU_value,(test_value_norm-CPU_value));
         result++;
     }
 
     printf("%s (%s): ",prng->prng->name,HGPU_convert_precision_to_str(prng->parameters->precision));
+    if (distribution!=HGPU_PRNG_distribution_uniform) {
+        if (distribution_parameter>0.0)
+            printf("[%s %g] ",HGPU_convert_distribution_to_str(distribution),distribution_parameter);
+        else
+            printf("[%s] ",HGPU_convert_distribution_to_str(distribution));
+    }
 
     if (result)
         printf("%u test(s) failed!!!\n",result);
     else
         printf("all tests passed\n");
 
+    free(GPU_results);
     free(CPU_results);
     HGPU_PRNG_and_buffers_free(context,prng);
     return result;
 }
 
+// test raw integer output (PRNs are precision-independent and should coincide exactly)
+unsigned int
+HGPU_PRNG_test_output(HGPU_GPU_context* context,HGPU_parameter** parameters,const HGPU_PRNG_description* prng_descr,unsigned int randseries,
+               HGPU_PRNG_output_format output_format,unsigned int number,u64_T test_value){
+    unsigned int result = 0;
+
+    HGPU_PRNG_set_default_precision(HGPU_precision_single);
+    HGPU_PRNG_set_default_randseries(randseries);
+    HGPU_PRNG_set_default_samples(number);
+
+    HGPU_parameter* parameter_instances  = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_INSTANCES);
+    if (parameter_instances && (parameter_instances->value_text)) HGPU_PRNG_set_default_instances(parameter_instances->value_integer);
+
+    HGPU_PRNG* prng = HGPU_PRNG_new(prng_descr);
+    if (randseries) HGPU_PRNG_set_randseries(prng,randseries);
+    HGPU_PRNG_set_output_format(prng,output_format);
+    u64_T* CPU_results = (u64_T*) calloc(number+1,sizeof(u64_T));
+    if (!CPU_results)
+        HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for results");
+
+    unsigned int prng_id = HGPU_PRNG_init(context,prng);
+    HGPU_PRNG_produce_CPU_integer(prng,&CPU_results,number);
+
+    u64_T CPU_value = CPU_results[number-1];
+
+    HGPU_PRNG_produce(context,prng_id);
+    unsigned int number_of_prns = MIN(number,prng->parameters->samples * HGPU_PRNG_get_output_values(prng));
+    u64_T* GPU_results = (u64_T*) calloc(number+1,sizeof(u64_T));
+    if (!GPU_results)
+        HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for results");
+    HGPU_PRNG_GPU_copy_uint_to_host(context,prng,GPU_results,0,number_of_prns);
+    for (unsigned int i=0; i<number_of_prns; ++i) {
+        u64_T GPU_prn = GPU_results[i];
+        u64_T CPU_prn = CPU_results[i];
+        if (GPU_prn!=CPU_prn) {
+            printf("[%u]:\t  GPU: %20llu      CPU: %20llu\n",(unsigned int) i,(llu_T) GPU_prn,(llu_T) CPU_prn);
+            result++;
+        }
+    }
+
+    if (CPU_value!=test_value) {
+        printf("Expected: %20llu    Generated: %20llu\n",(llu_T) test_value,(llu_T) CPU_value);
+        result++;
+    }
+
+    printf("%s (%s): ",prng->prng->name,HGPU_convert_output_format_to_str(prng->parameters->output_format));
+
+    if (result)
+        printf("%u test(s) failed!!!\n",result);
+    else
+        printf("all tests passed\n");
+
+    free(GPU_results);
+    free(CPU_results);
+    HGPU_PRNG_and_buffers_free(context,prng);
+    return result;
+}
+
+// test PRNG split into slices with substreams: slices (both on the same device here) should reproduce
+// the single-device layout of streams exactly
+unsigned int
+HGPU_PRNG_test_multi(HGPU_GPU_context* context,HGPU_parameter** parameters,const HGPU_PRNG_description* prng_descr,unsigned int randseries,
+               unsigned int number){
+    unsigned int result = 0;
+
+    HGPU_PRNG_set_default_precision(HGPU_precision_single);
+    HGPU_PRNG_set_default_randseries(randseries);
+    HGPU_PRNG_set_default_samples(number);
+
+    unsigned int instances = HGPU_GPU_device_get_max_memory_width(context->device);
+    HGPU_parameter* parameter_instances  = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_INSTANCES);
+    if (parameter_instances && (parameter_instances->value_text)) instances = parameter_instances->value_integer;
+    instances = MAX(2,instances);
+
+    HGPU_PRNG* prng = HGPU_PRNG_new(prng_descr);
+    if (randseries) HGPU_PRNG_set_randseries(prng,randseries);
+    HGPU_PRNG_set_instances(prng,instances);
+    HGPU_PRNG_set_samples(prng,1 + (number - 1) / instances);
+    HGPU_PRNG_set_substream(prng,((u64_T) prng->parameters->samples) * HGPU_PRNG_get_output_type_values(prng)); // PRNs of one stream
+
+    HGPU_PRNG* prng_single = HGPU_PRNG_clone(prng);
+    HGPU_PRNG_init(context,prng_single);
+    HGPU_PRNG_produce(context,prng_single->parameters->id_kernel_produce);
+    unsigned int lanes = 4;
+    size_t number_of_prns = HGPU_PRNG_GPU_get_buffer_prns(prng_single,&lanes);
+    double* single_results = (double*) calloc(number_of_prns,sizeof(double));
+    double* multi_results  = (double*) calloc(number_of_prns,sizeof(double));
+    if ((!single_results) || (!multi_results))
+        HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for results");
+    HGPU_PRNG_GPU_copy_to_host(context,prng_single,single_results,0,number_of_prns);
+
+    HGPU_GPU_context* contexts[] = {context,context,NULL};
+    const double productivity[]  = {1.0,1.0};
+    HGPU_PRNG_multi* multi = HGPU_PRNG_multi_new(contexts,prng);
+    HGPU_PRNG_multi_init(multi,productivity);
+    HGPU_PRNG_multi_produce(multi);
+    size_t number_of_multi_prns = HGPU_PRNG_multi_copy_to_host(multi,multi_results,0,number_of_prns);
+
+    if (number_of_multi_prns!=number_of_prns) {
+        printf("Expected: %u PRNs    Copied: %u PRNs\n",(unsigned int) number_of_prns,(unsigned int) number_of_multi_prns);
+        result++;
+    }
+    for (size_t i=0; i<number_of_multi_prns; ++i) {
+        if (single_results[i]!=multi_results[i]) {
+            printf("[%u]:\t  single: % .20e      multi: % .20e\n",(unsigned int) i,single_results[i],multi_results[i]);
+            result++;
+        }
+    }
+
+    printf("%s (%u slices): ",prng->prng->name,multi->number_of_devices);
+
+    if (result)
+        printf("%u test(s) failed!!!\n",result);
+    else
+        printf("all tests passed\n");
+
+    free(multi_results);
+    free(single_results);
+    HGPU_PRNG_multi_free(multi);
+    HGPU_PRNG_and_buffers_free(context,prng_single);
+    HGPU_PRNG_free(prng);
+    return result;
+}
 
 double
 HGPU_PRNG_benchmark(HGPU_GPU_context* context,HGPU_parameter** parameters,const HGPU_PRNG_description* prng_descr,HGPU_precision precision){
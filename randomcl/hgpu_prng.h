@@ -48,7 +48,10 @@
 
 #define PRNGCL_ROOT_PATH    "randomcl/"     // global root path to OpenCL-files
 
+#define HGPU_PRNG_PIPELINE_MAX_DEPTH 4 // maximal number of randoms buffers in production pipeline
+
 #define PRNGCL_MD5_INIT         // if defined then use MD5 hashing for initialization (to overcome timer-initialization problem), otherwise - plain initialization
+// PRNGCL_EMBEDDED_SOURCES  // if defined then OpenCL-files are embedded into binary (randomcl/prngcl_sources.cpp is generated by Makefile), otherwise - read from disk
 
 #ifdef __cplusplus
 extern "C" {
@@ -63,6 +66,22 @@ extern "C" {
                      unsigned int   id_buffer_seeds;
                      unsigned int   id_buffer_randoms;
                      unsigned int   id_kernel_produce;
+                     unsigned int   id_kernel_skip;
+                            u64_T   substream;            // substream length for partitioning of one stream among instances (0 = independent seeding)
+                     unsigned int   instances_first;      // global index of the first instance (slice of instances on one of several devices, see HGPU_PRNG_multi)
+                     unsigned int   local_size;           // work-group size of production kernel (0 = chosen by OpenCL runtime)
+                             bool   device_api;           // PRNs are produced inside consumer kernels by device-side API (no randoms buffer and production kernel)
+           HGPU_PRNG_distribution   distribution;         // output distribution of PRNs (uniform by default)
+                           double   normal_mean;          // mean of normal distribution (of logarithm for log-normal distribution)
+                           double   normal_sigma;         // standard deviation of normal distribution (of logarithm for log-normal distribution)
+                           double   lambda;               // rate of exponential distribution, mean of Poisson distribution
+                           double   gamma_shape;          // shape of Gamma distribution
+                           double   gamma_scale;          // scale of Gamma distribution
+          HGPU_PRNG_output_format   output_format;        // format of PRNs in randoms buffer (floating point by default, raw integers for integer PRNGs)
+                     unsigned int   pipeline_depth;       // number of randoms buffers in production pipeline (0 = no pipeline)
+                     unsigned int   pipeline_head;        // index of the oldest produced buffer in pipeline (next to be handed out)
+                     unsigned int   pipeline_current;     // index of buffer handed out to consumer (pipeline_depth if none)
+                     unsigned int   id_buffer_pipeline[HGPU_PRNG_PIPELINE_MAX_DEPTH]; // randoms buffers of pipeline (the first one is id_buffer_randoms)
     } HGPU_PRNG_parameters;
 
     typedef struct{ 
@@ -79,11 +98,13 @@ extern "C" {
                              void   (*parameter_init)(void* state,HGPU_parameter** parameters); // PRNG parameters initialization by (HGPU_parameter) array (NULL if absent)
                      unsigned int   (*CPU_produce_one_uint)(void* state);               // produce one unsigned integer on CPU PRNG subroutine (NULL if absent)
                            double   (*CPU_produce_one_double)(void* state);             // produce one unsigned integer on CPU PRNG subroutine
+                             void   (*CPU_skip)(void* state,u64_T n);                   // skip-ahead of CPU PRNG state by n unsigned integers (NULL if absent)
                              void   (*GPU_init)(HGPU_GPU_context* context,void* state,HGPU_PRNG_parameters* PRNG_parameters); // GPU init for initial seed table
                              char*  (*GPU_options)(HGPU_GPU_context* context,void* state,HGPU_PRNG_parameters* PRNG_parameters); // setup additional OpenCL compilation options
                        const char*  prng_src;             // PRNG src
                        const char*  init_kernel;          // PRNG init kernel name
                        const char*  production_kernel;    // PRNG production kernel name
+                       const char*  skip_kernel;          // PRNG skip-ahead kernel name (NULL if absent)
     } HGPU_PRNG_description;
 
     typedef struct{
@@ -92,6 +113,15 @@ extern "C" {
              HGPU_PRNG_parameters*  parameters;
     } HGPU_PRNG;
 
+    // PRNG, which instances are split among several devices (one context per device)
+    typedef struct{
+                        HGPU_PRNG*  prng;                 // copy of master PRNG with parameters and CPU state of whole set of instances
+                 HGPU_GPU_context** context;              // contexts of devices (NULL-terminated array, see HGPU_GPU_contexts_select_auto)
+                       HGPU_PRNG**  prng_device;          // PRNG with slice of instances on every device
+                     unsigned int*  instances_first;      // first instance of slice on every device
+                     unsigned int   number_of_devices;
+    } HGPU_PRNG_multi;
+
     typedef struct {
         unsigned int x;
         unsigned int y;
@@ -99,6 +129,12 @@ extern "C" {
         unsigned int t;
     } HGPU_PRNG_internal_state_t;
 
+    // structure for OpenCL-file embedded into binary
+    typedef struct {
+                      const char*  name;                 // name of OpenCL-file (relative to root path)
+                      const char*  source;               // OpenCL source (with inlined #include-s)
+    } HGPU_PRNG_embedded_source;
+
 
     extern const HGPU_PRNG_description*  HGPU_PRNG_XOR128;
     extern const HGPU_PRNG_description*  HGPU_PRNG_CONSTANT;
@@ -108,6 +144,7 @@ extern "C" {
     extern const HGPU_PRNG_description*  HGPU_PRNG_RANLUX;
     extern const HGPU_PRNG_description*  HGPU_PRNG_PM;
     extern const HGPU_PRNG_description*  HGPU_PRNG_MRG32K3A;
+    extern const HGPU_PRNG_description*  HGPU_PRNG_PHILOX;
     //  extern const PRNG_description* PRNG_...;
     //  add here other PRNG implementations
 
@@ -117,6 +154,7 @@ extern const HGPU_PRNG_description* HGPU_PRNG_default;
             extern HGPU_precision   HGPU_PRNG_default_precision;
               extern unsigned int   HGPU_PRNG_default_instances;
               extern unsigned int   HGPU_PRNG_default_samples;
+extern const HGPU_PRNG_embedded_source  HGPU_PRNG_embedded_sources[];
 
     // functions and procedures __________________________________________________________________________________________
                              void   HGPU_PRNG_srand(unsigned int randseries);
@@ -125,7 +163,19 @@ extern const HGPU_PRNG_description* HGPU_PRNG_default;
                            double   HGPU_PRNG_double_from_uint(unsigned int rnd1,unsigned int rnd2,unsigned int rnd_min,unsigned int rnd_max,double k);
                            double   HGPU_PRNG_double_from_float(unsigned int rnd1,unsigned int rnd2,double rnd_min,double rnd_max,double k);
 
+                            u32_T   HGPU_PRNG_skip_powmod(u32_T a,u64_T n,u32_T m);
+                             void   HGPU_PRNG_skip_matrix_powmod(const u32_T* matrix,u64_T n,u32_T m,u32_T* result);
+                             void   HGPU_PRNG_skip_gf2_powmod(const u32_T* polynomial,unsigned int words,u64_T n,u32_T* result);
+
                      unsigned int   HGPU_PRNG_init(HGPU_GPU_context* context,HGPU_PRNG* prng);
+                     unsigned int   HGPU_PRNG_init_device_api(HGPU_GPU_context* context,HGPU_PRNG* prng);
+                       cl_program   HGPU_PRNG_program_new(HGPU_GPU_context* context,HGPU_PRNG* prng,const char* source);
+                      const char*   HGPU_PRNG_source_get_embedded(const char* file_name);
+                             char*  HGPU_PRNG_source_read(const char* file_name);
+                     unsigned int   HGPU_PRNG_precompile_all(HGPU_GPU_context* context,const HGPU_precision* precisions);
+                     unsigned int   HGPU_PRNG_kernel_bind_seeds(HGPU_GPU_context* context,unsigned int kernel_id,HGPU_PRNG* prng);
+                     unsigned int   HGPU_PRNG_kernel_bind_randoms(HGPU_GPU_context* context,HGPU_PRNG* prng,unsigned int randoms_id);
+                     unsigned int   HGPU_PRNG_GPU_randoms_init(HGPU_GPU_context* context,HGPU_PRNG_parameters* PRNG_parameters,const char* buffer_name);
 
       const HGPU_PRNG_description** HGPU_PRNG_descriptions_new(void);
       const HGPU_PRNG_description*  HGPU_PRNG_description_get_with_name(const char* prng_name);
@@ -143,8 +193,15 @@ extern const HGPU_PRNG_description* HGPU_PRNG_default;
                              void   HGPU_PRNG_set_precision(HGPU_PRNG* prng,HGPU_precision precision);
                              void   HGPU_PRNG_set_instances(HGPU_PRNG* prng,unsigned int instances);
                              void   HGPU_PRNG_set_samples(HGPU_PRNG* prng,unsigned int samples);
+                             void   HGPU_PRNG_set_substream(HGPU_PRNG* prng,u64_T substream);
+                             void   HGPU_PRNG_set_distribution(HGPU_PRNG* prng,HGPU_PRNG_distribution distribution);
+                             void   HGPU_PRNG_set_normal(HGPU_PRNG* prng,double mean,double sigma);
+                             void   HGPU_PRNG_set_lambda(HGPU_PRNG* prng,double lambda);
+                             void   HGPU_PRNG_set_gamma(HGPU_PRNG* prng,double shape,double scale);
+                             void   HGPU_PRNG_set_output_format(HGPU_PRNG* prng,HGPU_PRNG_output_format output_format);
                              void   HGPU_PRNG_change_samples(HGPU_GPU_context* context,HGPU_PRNG* prng,unsigned int samples);
                      unsigned int   HGPU_PRNG_get_output_type_values(HGPU_PRNG* prng);
+                     unsigned int   HGPU_PRNG_get_output_values(HGPU_PRNG* prng);
 
                         HGPU_PRNG*  HGPU_PRNG_new(const HGPU_PRNG_description* prng_descr);
                         HGPU_PRNG*  HGPU_PRNG_new_default(void);
@@ -157,20 +214,49 @@ extern const HGPU_PRNG_description* HGPU_PRNG_default;
                            double   HGPU_PRNG_produce_CPU_uintN_one( HGPU_PRNG* prng,unsigned int prns_drop);
 
                              void   HGPU_PRNG_produce_CPU(HGPU_PRNG* prng,double** randoms_CPU,unsigned int number_of_prns);
+                             void   HGPU_PRNG_produce_CPU_integer(HGPU_PRNG* prng,u64_T** randoms_CPU,unsigned int number_of_prns);
                              void   HGPU_PRNG_produce(HGPU_GPU_context* context,unsigned int prng_kernel_id);
+                             void   HGPU_PRNG_produce_n(HGPU_GPU_context* context,HGPU_PRNG* prng,unsigned int n,unsigned int consumer_kernel_id);
+                     unsigned int   HGPU_PRNG_pipeline_init(HGPU_GPU_context* context,HGPU_PRNG* prng,unsigned int depth);
+                     unsigned int   HGPU_PRNG_pipeline_next(HGPU_GPU_context* context,HGPU_PRNG* prng);
+                             void   HGPU_PRNG_pipeline_release(HGPU_GPU_context* context,HGPU_PRNG* prng);
+
+                             void   HGPU_PRNG_skip(HGPU_PRNG* prng,u64_T n);
+                             void   HGPU_PRNG_GPU_skip(HGPU_GPU_context* context,HGPU_PRNG* prng,u64_T n);
+
+                       HGPU_PRNG_multi*  HGPU_PRNG_multi_new(HGPU_GPU_context** contexts,HGPU_PRNG* prng);
+                             void   HGPU_PRNG_multi_init(HGPU_PRNG_multi* multi,const double* productivity);
+                             void   HGPU_PRNG_multi_produce(HGPU_PRNG_multi* multi);
+                           size_t   HGPU_PRNG_multi_copy_to_host(HGPU_PRNG_multi* multi,double* dst,size_t first,size_t count);
+                           size_t   HGPU_PRNG_multi_copy_uint_to_host(HGPU_PRNG_multi* multi,u64_T* dst,size_t first,size_t count);
+                             void   HGPU_PRNG_multi_free(HGPU_PRNG_multi* multi);
 
                              void   HGPU_PRNG_free(HGPU_PRNG* prng);
                              void   HGPU_PRNG_and_buffers_free(HGPU_GPU_context* context,HGPU_PRNG* prng);
 
                            double   HGPU_PRNG_GPU_get_from_buffer(HGPU_GPU_context* context,HGPU_PRNG* prng,unsigned int index);
+                            u64_T   HGPU_PRNG_GPU_get_uint_from_buffer(HGPU_GPU_context* context,HGPU_PRNG* prng,unsigned int index);
+                           size_t   HGPU_PRNG_GPU_copy_to_host(HGPU_GPU_context* context,HGPU_PRNG* prng,double* dst,size_t first,size_t count);
+                           size_t   HGPU_PRNG_GPU_copy_uint_to_host(HGPU_GPU_context* context,HGPU_PRNG* prng,u64_T* dst,size_t first,size_t count);
 
                              char*  HGPU_PRNG_make_header(HGPU_PRNG* prng);
                              void   HGPU_PRNG_write_results(HGPU_GPU_context* context,HGPU_PRNG* prng,const char* file_path,const char* file_name);
                              void   HGPU_PRNG_write_output_text(HGPU_GPU_context* context,HGPU_PRNG* prng,const char* file_path,const char* file_name);
-//                             void   HGPU_PRNG_write_output_binary(HGPU_GPU_context* context,HGPU_PRNG* prng,const char* file_path,const char* file_name);
+                             void   HGPU_PRNG_write_output_binary(HGPU_GPU_context* context,HGPU_PRNG* prng,const char* file_path,const char* file_name);
+                            u64_T   HGPU_PRNG_write_output_binary_stream(HGPU_GPU_context* context,HGPU_PRNG* prng,FILE* stream,u64_T bytes);
 
                      unsigned int   HGPU_PRNG_test(HGPU_GPU_context* context,HGPU_parameter** parameters,const HGPU_PRNG_description* prng_descr,
                                                    unsigned int randseries,HGPU_precision precision,unsigned int number,double test_value);
+                     unsigned int   HGPU_PRNG_test_distribution(HGPU_GPU_context* context,HGPU_parameter** parameters,const HGPU_PRNG_description* prng_descr,
+                                                   unsigned int randseries,HGPU_precision precision,HGPU_PRNG_distribution distribution,
+                                                   unsigned int number,double test_value);
+                     unsigned int   HGPU_PRNG_test_distribution_with_parameter(HGPU_GPU_context* context,HGPU_parameter** parameters,const HGPU_PRNG_description* prng_descr,
+                                                   unsigned int randseries,HGPU_precision precision,HGPU_PRNG_distribution distribution,
+                                                   double distribution_parameter,unsigned int number,double test_value);
+                     unsigned int   HGPU_PRNG_test_output(HGPU_GPU_context* context,HGPU_parameter** parameters,const HGPU_PRNG_description* prng_descr,
+                                                   unsigned int randseries,HGPU_PRNG_output_format output_format,unsigned int number,u64_T test_value);
+                     unsigned int   HGPU_PRNG_test_multi(HGPU_GPU_context* context,HGPU_parameter** parameters,const HGPU_PRNG_description* prng_descr,
+                                                   unsigned int randseries,unsigned int number);
 
                            double   HGPU_PRNG_benchmark(HGPU_GPU_context* context,HGPU_parameter** parameters,
                                                    const HGPU_PRNG_description* prng_descr,HGPU_precision precision);
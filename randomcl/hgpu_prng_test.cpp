@@ -53,6 +53,7 @@ HGPU_PRNG_tests(HGPU_GPU_context* context,HGPU_parameter** parameters){
     result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_RANMAR,  1,HGPU_precision_single,1000000,0.54384857416152954);
     result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_RANLUX,  1,HGPU_precision_single,1000000,0.085599660873413086);
     result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_MRG32K3A,1,HGPU_precision_single,1000000,0.51180928945541382);
+    result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_PHILOX,  1,HGPU_precision_single,1000000,0.40035089850425720);
 
 
     // Toy PRNGs:
@@ -65,6 +66,33 @@ HGPU_PRNG_tests(HGPU_GPU_context* context,HGPU_parameter** parameters){
     result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_RANMAR,  1,HGPU_precision_double,1000000,0.17660977581855250);
     result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_RANLUX,  1,HGPU_precision_double,1000000,0.22363614294126266);
     result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_MRG32K3A,1,HGPU_precision_double,1000000,0.73900908237277685);
+    result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_PHILOX,  1,HGPU_precision_double,1000000,0.17179334104766336);
+
+    // Output distributions:
+    result += HGPU_PRNG_test_distribution(context,parameters,HGPU_PRNG_XOR128,  1,HGPU_precision_single,HGPU_PRNG_distribution_normal,      1000000,0.94426518678665161);
+    result += HGPU_PRNG_test_distribution(context,parameters,HGPU_PRNG_MRG32K3A,1,HGPU_precision_single,HGPU_PRNG_distribution_normal_polar,1000000,-1.3986637592315674);
+    result += HGPU_PRNG_test_distribution(context,parameters,HGPU_PRNG_XOR128,  1,HGPU_precision_double,HGPU_PRNG_distribution_lognormal,   1000000,0.18966323818428579);
+    result += HGPU_PRNG_test_distribution(context,parameters,HGPU_PRNG_PHILOX,  1,HGPU_precision_double,HGPU_PRNG_distribution_normal,      1000000,1.3297396662307914);
+    result += HGPU_PRNG_test_distribution(context,parameters,HGPU_PRNG_RANLUX,  1,HGPU_precision_single,HGPU_PRNG_distribution_exponential, 1000000,2.4580738544464111);
+    result += HGPU_PRNG_test_distribution(context,parameters,HGPU_PRNG_MRG32K3A,1,HGPU_precision_double,HGPU_PRNG_distribution_poisson,     1000000,2.0);
+    result += HGPU_PRNG_test_distribution(context,parameters,HGPU_PRNG_PHILOX,  1,HGPU_precision_double,HGPU_PRNG_distribution_gamma,       1000000,0.61357523917139745);
+
+    // Distributions with parameters (Poisson by PTRS for lambda>=10, Gamma with shape<1):
+    result += HGPU_PRNG_test_distribution_with_parameter(context,parameters,HGPU_PRNG_MRG32K3A,1,HGPU_precision_double,HGPU_PRNG_distribution_poisson,20.0,1000000,18.0);
+    result += HGPU_PRNG_test_distribution_with_parameter(context,parameters,HGPU_PRNG_XOR128,  1,HGPU_precision_single,HGPU_PRNG_distribution_poisson,20.0,1000000,12.0);
+    result += HGPU_PRNG_test_distribution_with_parameter(context,parameters,HGPU_PRNG_PHILOX,  1,HGPU_precision_double,HGPU_PRNG_distribution_gamma,  0.5, 1000000,0.2404874832564631);
+    result += HGPU_PRNG_test_distribution_with_parameter(context,parameters,HGPU_PRNG_RANECU,  1,HGPU_precision_single,HGPU_PRNG_distribution_gamma,  0.5, 1000000,0.3934406042098999);
+
+    // Raw integer output:
+    result += HGPU_PRNG_test_output(context,parameters,HGPU_PRNG_XOR128,1,HGPU_PRNG_output_format_uint32,1000000,329492496ULL);
+    result += HGPU_PRNG_test_output(context,parameters,HGPU_PRNG_RANECU,1,HGPU_PRNG_output_format_uint32,1000000,2066308822ULL);
+    result += HGPU_PRNG_test_output(context,parameters,HGPU_PRNG_PHILOX,1,HGPU_PRNG_output_format_uint64,1000000,3169027798693021723ULL);
+    result += HGPU_PRNG_test_output(context,parameters,HGPU_PRNG_XOR7,  1,HGPU_PRNG_output_format_uint64,1000000,5104140508039160393ULL);
+
+    // Slices of substreams:
+    result += HGPU_PRNG_test_multi(context,parameters,HGPU_PRNG_PM,    1,1000000);
+    result += HGPU_PRNG_test_multi(context,parameters,HGPU_PRNG_XOR128,1,1000000);
+    result += HGPU_PRNG_test_multi(context,parameters,HGPU_PRNG_PHILOX,1,1000000);
 #else
     // Toy PRNGs:
     result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_PM,      1,HGPU_precision_single,10000,0.8641089363322169);
@@ -76,6 +104,7 @@ HGPU_PRNG_tests(HGPU_GPU_context* context,HGPU_parameter** parameters){
     result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_RANMAR,  1,HGPU_precision_single,1000000,0.9911311864852905);
     result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_RANLUX,  1,HGPU_precision_single,1000000,0.42132478952407837);
     result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_MRG32K3A,1,HGPU_precision_single,1000000,0.8171486894057429);
+    result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_PHILOX,  1,HGPU_precision_single,1000000,0.39567875862121582);
 
 
     // Toy PRNGs:
@@ -88,6 +117,33 @@ HGPU_PRNG_tests(HGPU_GPU_context* context,HGPU_parameter** parameters){
     result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_RANMAR,  1,HGPU_precision_double,1000000,0.6419413344753121);
     result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_RANLUX,  1,HGPU_precision_double,1000000,0.16665428407858204);
     result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_MRG32K3A,1,HGPU_precision_double,1000000,0.0075525209409365449);
+    result += HGPU_PRNG_test(context,parameters,HGPU_PRNG_PHILOX,  1,HGPU_precision_double,1000000,0.83774432325461656);
+
+    // Output distributions:
+    result += HGPU_PRNG_test_distribution(context,parameters,HGPU_PRNG_XOR128,  1,HGPU_precision_single,HGPU_PRNG_distribution_normal,      1000000,-1.1042314767837524);
+    result += HGPU_PRNG_test_distribution(context,parameters,HGPU_PRNG_MRG32K3A,1,HGPU_precision_single,HGPU_PRNG_distribution_normal_polar,1000000,-0.39751306176185608);
+    result += HGPU_PRNG_test_distribution(context,parameters,HGPU_PRNG_XOR128,  1,HGPU_precision_double,HGPU_PRNG_distribution_lognormal,   1000000,0.40393359914654975);
+    result += HGPU_PRNG_test_distribution(context,parameters,HGPU_PRNG_PHILOX,  1,HGPU_precision_double,HGPU_PRNG_distribution_normal,      1000000,-1.6779901298221149);
+    result += HGPU_PRNG_test_distribution(context,parameters,HGPU_PRNG_RANLUX,  1,HGPU_precision_single,HGPU_PRNG_distribution_exponential, 1000000,0.86435127258300781);
+    result += HGPU_PRNG_test_distribution(context,parameters,HGPU_PRNG_MRG32K3A,1,HGPU_precision_double,HGPU_PRNG_distribution_poisson,     1000000,0.0);
+    result += HGPU_PRNG_test_distribution(context,parameters,HGPU_PRNG_PHILOX,  1,HGPU_precision_double,HGPU_PRNG_distribution_gamma,       1000000,1.3095346580798972);
+
+    // Distributions with parameters (Poisson by PTRS for lambda>=10, Gamma with shape<1):
+    result += HGPU_PRNG_test_distribution_with_parameter(context,parameters,HGPU_PRNG_MRG32K3A,1,HGPU_precision_double,HGPU_PRNG_distribution_poisson,20.0,1000000,25.0);
+    result += HGPU_PRNG_test_distribution_with_parameter(context,parameters,HGPU_PRNG_XOR128,  1,HGPU_precision_single,HGPU_PRNG_distribution_poisson,20.0,1000000,15.0);
+    result += HGPU_PRNG_test_distribution_with_parameter(context,parameters,HGPU_PRNG_PHILOX,  1,HGPU_precision_double,HGPU_PRNG_distribution_gamma,  0.5, 1000000,0.69434488061284727);
+    result += HGPU_PRNG_test_distribution_with_parameter(context,parameters,HGPU_PRNG_RANECU,  1,HGPU_precision_single,HGPU_PRNG_distribution_gamma,  0.5, 1000000,0.42818203568458557);
+
+    // Raw integer output:
+    result += HGPU_PRNG_test_output(context,parameters,HGPU_PRNG_XOR128,1,HGPU_PRNG_output_format_uint32,1000000,2937610824ULL);
+    result += HGPU_PRNG_test_output(context,parameters,HGPU_PRNG_RANECU,1,HGPU_PRNG_output_format_uint32,1000000,388852135ULL);
+    result += HGPU_PRNG_test_output(context,parameters,HGPU_PRNG_PHILOX,1,HGPU_PRNG_output_format_uint64,1000000,15453655127379716660ULL);
+    result += HGPU_PRNG_test_output(context,parameters,HGPU_PRNG_XOR7,  1,HGPU_PRNG_output_format_uint64,1000000,14007416623583708361ULL);
+
+    // Slices of substreams:
+    result += HGPU_PRNG_test_multi(context,parameters,HGPU_PRNG_PM,    1,1000000);
+    result += HGPU_PRNG_test_multi(context,parameters,HGPU_PRNG_XOR128,1,1000000);
+    result += HGPU_PRNG_test_multi(context,parameters,HGPU_PRNG_PHILOX,1,1000000);
 #endif
 
     printf(" **************************************************\n");
@@ -109,6 +165,9 @@ HGPU_PRNG_benchmarks(HGPU_GPU_context* context,HGPU_parameter** parameters){
         printf("\nStarted at: %s (%u tics/sec)\n\n",timestamp,(unsigned int) CLOCKS_PER_SEC);
     free(timestamp);
 
+    // fill program cache with all PRNG programs at once (compiled in parallel)
+    HGPU_PRNG_precompile_all(context,NULL);
+
     result += HGPU_PRNG_benchmark(context,parameters,HGPU_PRNG_CONSTANT,HGPU_precision_single);
     result += HGPU_PRNG_benchmark(context,parameters,HGPU_PRNG_PM,      HGPU_precision_single);
     result += HGPU_PRNG_benchmark(context,parameters,HGPU_PRNG_XOR128,  HGPU_precision_single);
@@ -117,6 +176,7 @@ HGPU_PRNG_benchmarks(HGPU_GPU_context* context,HGPU_parameter** parameters){
     result += HGPU_PRNG_benchmark(context,parameters,HGPU_PRNG_RANMAR,  HGPU_precision_single);
     result += HGPU_PRNG_benchmark(context,parameters,HGPU_PRNG_RANLUX,  HGPU_precision_single);
     result += HGPU_PRNG_benchmark(context,parameters,HGPU_PRNG_MRG32K3A,HGPU_precision_single);
+    result += HGPU_PRNG_benchmark(context,parameters,HGPU_PRNG_PHILOX,  HGPU_precision_single);
 
     result += HGPU_PRNG_benchmark(context,parameters,HGPU_PRNG_CONSTANT,HGPU_precision_double);
     result += HGPU_PRNG_benchmark(context,parameters,HGPU_PRNG_PM,      HGPU_precision_double);
@@ -126,6 +186,7 @@ HGPU_PRNG_benchmarks(HGPU_GPU_context* context,HGPU_parameter** parameters){
     result += HGPU_PRNG_benchmark(context,parameters,HGPU_PRNG_RANMAR,  HGPU_precision_double);
     result += HGPU_PRNG_benchmark(context,parameters,HGPU_PRNG_RANLUX,  HGPU_precision_double);
     result += HGPU_PRNG_benchmark(context,parameters,HGPU_PRNG_MRG32K3A,HGPU_precision_double);
+    result += HGPU_PRNG_benchmark(context,parameters,HGPU_PRNG_PHILOX,  HGPU_precision_double);
 
     timestamp = HGPU_timer_get_current_datetime();
         printf("\nFinished at: %s\n",timestamp);
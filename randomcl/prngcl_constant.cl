@@ -41,20 +41,38 @@
 
 #include "prngcl_common.cl"
 
+typedef uint constant_series_state;  // CONSTANT PRNG has no state
+
+__attribute__((always_inline)) constant_series_state
+constant_series_state_load(__global uint4* seed_table)
+{
+    return 0;
+}
+
+__attribute__((always_inline)) void
+constant_series_state_store(__global uint4* seed_table,constant_series_state* state)
+{
+}
+
+__attribute__((always_inline)) hgpu_float4
+constant_series_next_float4(constant_series_state* state)
+{
+    return (hgpu_float4) CONSTANT_FP;
+}
+
+#include "prngcl_distribution.cl"
+
 /**
  * generates the series of constant values predefined by CONSTANT_FP parameter
  * @param randoms output buffer for generated PRNs
  * @param N number of PRNs to be produced
  */
 __kernel void
-constant_series(__global hgpu_float4* randoms,
+constant_series(__global prng_output_t* randoms,
                 const uint N)
 {
-    uint giddst = GID;
-        for (uint i = 0; i < N; i++) {
-        randoms[giddst] = (hgpu_float4) CONSTANT_FP;
-        giddst += GID_SIZE;
-    }
+    constant_series_state state = 0;
+    prng_produce(randoms,&state,N);
 }
 
 
@@ -56,6 +56,7 @@
             static void   HGPU_PRNG_CONSTANT_initialize(void* PRNG_state, unsigned int PRNG_randseries);
     static unsigned int   HGPU_PRNG_CONSTANT_produce_one_uint_CPU(void* PRNG_state);
           static double   HGPU_PRNG_CONSTANT_produce_one_double_CPU(void* PRNG_state);
+            static void   HGPU_PRNG_CONSTANT_skip_CPU(void* PRNG_state,u64_T n);
             static void   HGPU_PRNG_CONSTANT_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters);
             static char*  HGPU_PRNG_CONSTANT_options_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters);
             static void   HGPU_PRNG_CONSTANT_parameters_set(void* PRNG_state,HGPU_parameter** parameters);
@@ -81,24 +82,15 @@ HGPU_PRNG_CONSTANT_produce_one_double_CPU(void* PRNG_state){
 }
 
 static void
-HGPU_PRNG_CONSTANT_init_GPU(HGPU_GPU_context* context,void*,HGPU_PRNG_parameters* PRNG_parameters){
-    size_t randoms_size             = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * PRNG_parameters->samples);
-    cl_float4*  PRNG_randoms        = NULL;
-    cl_double4* PRNG_randoms_double = NULL;
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        PRNG_randoms_double = (cl_double4*) calloc(randoms_size,sizeof(cl_double4));
-    else
-        PRNG_randoms        = (cl_float4*)  calloc(randoms_size,sizeof(cl_float4));
-    if ((!PRNG_randoms_double) && (!PRNG_randoms))
-        HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for randoms");
+HGPU_PRNG_CONSTANT_skip_CPU(void*,u64_T){
+    // constant series does not depend on position
+}
 
+static void
+HGPU_PRNG_CONSTANT_init_GPU(HGPU_GPU_context* context,void*,HGPU_PRNG_parameters* PRNG_parameters){
     unsigned int randoms_id = 0;
 
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms_double,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_double4));
-    else
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_float4));
-    HGPU_GPU_context_buffer_set_name(context,randoms_id,(char*) "(CONSTANT) PRNG_randoms");
+    randoms_id = HGPU_PRNG_GPU_randoms_init(context,PRNG_parameters,"(CONSTANT) PRNG_randoms");
 
     PRNG_parameters->id_buffer_input_seeds = HGPU_GPU_MAX_BUFFERS;
     PRNG_parameters->id_buffer_seeds       = HGPU_GPU_MAX_BUFFERS;
@@ -143,12 +135,14 @@ HGPU_PRNG_CONSTANT_description = {
         &HGPU_PRNG_CONSTANT_parameters_set,           // PRNG additional parameters initialization
         &HGPU_PRNG_CONSTANT_produce_one_uint_CPU,     // PRNG production one unsigned integer
         &HGPU_PRNG_CONSTANT_produce_one_double_CPU,   // PRNG production one double
+        &HGPU_PRNG_CONSTANT_skip_CPU,                 // PRNG skip-ahead
         //
         &HGPU_PRNG_CONSTANT_init_GPU,                 // PRNG init for GPU procedure
         &HGPU_PRNG_CONSTANT_options_GPU,              // PRNG additional compilation options
         HGPU_PRNG_CL_FILE,                            // PRNG source codes
         NULL,                                         // PRNG init kernel
-        "constant_series"                             // PRNG production kernel
+        "constant_series",                            // PRNG production kernel
+        NULL                                          // PRNG skip-ahead kernel
 };
 
 const HGPU_PRNG_description*  HGPU_PRNG_CONSTANT  = &HGPU_PRNG_CONSTANT_description;
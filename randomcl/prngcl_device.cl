@@ -0,0 +1,122 @@
+/******************************************************************************
+ * @file     prngcl_device.cl
+ * @author   Vadim Demchik <vadimdi@yahoo.com>
+ * @version  1.1.2
+ *
+ * @brief    [PRNGCL library]
+ *           device-side PRNG interface for consumer kernels:
+ *           PRNs are produced inline instead of reading them from randoms buffer
+ *
+ *           prng_seed_t                  - element type of PRNG seed table
+ *           prng_state                   - PRNG state of work-item
+ *           prng_state_load(seed_table)  - load state of work-item GID from seed table
+ *           prng_next_float4(&state)     - produce next hgpu_float4 of PRNs
+ *           prng_next_uint4(&state)      - produce next uint4 of raw PRNs (if PRNG_HAS_NEXT_UINT4 is defined)
+ *           prng_state_store(seed_table,&state) - store state of work-item GID back to seed table
+ *           non-uniform PRNs are produced by functions of prngcl_distribution.cl (included by PRNG source)
+ *
+ *           consumer source is compiled by HGPU_PRNG_program_new (PRNG source is prepended),
+ *           consumer kernel should be run with global size equal to PRNG instances
+ *
+ *
+ * @section  LICENSE
+ *
+ * Copyright (c) 2013-2015 Vadim Demchik
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *    Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *****************************************************************************/
+
+#ifndef PRNGCL_DEVICE_CL
+#define PRNGCL_DEVICE_CL
+
+#if defined(PRNGCL_XOR128_CL)
+    #define prng_seed_t         uint4
+    #define prng_state          xor128_state
+    #define prng_state_load     xor128_state_load
+    #define prng_state_store    xor128_state_store
+    #define prng_next_float4    xor128_next_float4
+    #define prng_next_uint4     xor128_next_uint4
+    #define PRNG_HAS_NEXT_UINT4
+#elif defined(PRNGCL_XOR7_CL)
+    #define prng_seed_t         uint4
+    #define prng_state          xor7_state
+    #define prng_state_load     xor7_state_load
+    #define prng_state_store    xor7_state_store
+    #define prng_next_float4    xor7_next_float4
+    #define prng_next_uint4     xor7_next_uint4
+    #define PRNG_HAS_NEXT_UINT4
+#elif defined(PRNGCL_PM_CL)
+    #define prng_seed_t         uint4
+    #define prng_state          pm_state
+    #define prng_state_load     pm_state_load
+    #define prng_state_store    pm_state_store
+    #define prng_next_float4    pm_next_float4
+    #define prng_next_uint4     pm_next_uint4
+    #define PRNG_HAS_NEXT_UINT4
+#elif defined(PRNGCL_RANECU_CL)
+    #define prng_seed_t         uint4
+    #define prng_state          ranecu_state
+    #define prng_state_load     ranecu_state_load
+    #define prng_state_store    ranecu_state_store
+    #define prng_next_float4    ranecu_next_float4
+    #define prng_next_uint4     ranecu_next_uint4
+    #define PRNG_HAS_NEXT_UINT4
+#elif defined(PRNGCL_MRG32K3A_CL)
+    #define prng_seed_t         uint4
+    #define prng_state          mrg32k3a_state
+    #define prng_state_load     mrg32k3a_state_load
+    #define prng_state_store    mrg32k3a_state_store
+    #define prng_next_float4    mrg32k3a_next_float4
+#elif defined(PRNGCL_PHILOX_CL)
+    #define prng_seed_t         uint
+    #define prng_state          philox_state
+    #define prng_state_load     philox_state_load
+    #define prng_state_store    philox_state_store
+    #define prng_next_float4    philox_next_float4
+    #define prng_next_uint4     philox_next_uint4
+    #define PRNG_HAS_NEXT_UINT4
+#elif defined(PRNGCL_RANMAR_CL)
+    #define prng_seed_t         float4
+    #define prng_state          ranmar_state
+    #define prng_state_load     ranmar_state_load
+    #define prng_state_store    ranmar_state_store
+    #define prng_next_float4    ranmar_next_float4
+#elif defined(PRNGCL_RANLUX_CL)
+    #define prng_seed_t         float4
+    #define prng_state          ranlux_state
+    #define prng_state_load     ranlux_state_load
+    #define prng_state_store    ranlux_state_store
+    #define prng_next_float4    ranlux_next_float4
+#elif defined(PRNGCL_CONSTANT_CL)
+    #define prng_seed_t         uint4
+    #define prng_state          constant_series_state
+    #define prng_state_load     constant_series_state_load
+    #define prng_state_store    constant_series_state_store
+    #define prng_next_float4    constant_series_next_float4
+#else
+    #error "PRNG source should be included before prngcl_device.cl"
+#endif
+
+
+#endif
@@ -0,0 +1,341 @@
+/******************************************************************************
+ * @file     prngcl_distribution.cl
+ * @author   Vadim Demchik <vadimdi@yahoo.com>
+ * @version  1.1.2
+ *
+ * @brief    [PRNGCL library]
+ *           non-uniform output distributions of PRNs (selected by PRNG_DISTRIBUTION):
+ *
+ *           prng_next_normal_float4(&state)    - next hgpu_float4 of normal PRNs (PRNG_NORMAL_MEAN, PRNG_NORMAL_SIGMA)
+ *           prng_next_lognormal_float4(&state) - next hgpu_float4 of log-normal PRNs
+ *           prng_next_output_float4(&state)    - next hgpu_float4 of PRNs in PRNG_DISTRIBUTION
+ *           prng_produce(randoms,&state,N)     - write N prng_output_t of PRNs in PRNG_DISTRIBUTION (or raw PRNs, PRNG_OUTPUT)
+ *
+ *           normal PRNs are produced by Box-Muller transform of pairs (x,y) and (z,w) of uniform PRNs
+ *           or by Marsaglia polar method (PRNG_DISTRIBUTION_NORMAL_POLAR),
+ *           exponential PRNs (PRNG_LAMBDA) - by inversion,
+ *           Poisson PRNs (PRNG_LAMBDA) - by inversion or by PTRS method of W.Hormann (PRNG_POISSON_LARGE),
+ *           Gamma PRNs (PRNG_GAMMA_D, PRNG_GAMMA_C, PRNG_GAMMA_SCALE) - by Marsaglia-Tsang method
+ *
+ *           rejection-based samplers produce candidates by hgpu_float4 of uniform PRNs
+ *           and queue accepted ones, see prng_produce
+ *
+ *           raw integer output (PRNG_OUTPUT) is precision-independent: uint4 of PRNs (PRNG_OUTPUT_UINT32)
+ *           or ulong2 of pairs of consecutive PRNs (PRNG_OUTPUT_UINT64, high word first), distribution is ignored
+ *
+ *
+ * @section  LICENSE
+ *
+ * Copyright (c) 2013-2015 Vadim Demchik
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *    Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *****************************************************************************/
+
+#ifndef PRNGCL_DISTRIBUTION_CL
+#define PRNGCL_DISTRIBUTION_CL
+
+#include "prngcl_device.cl"
+
+#define PRNG_DISTRIBUTION_UNIFORM       0
+#define PRNG_DISTRIBUTION_NORMAL        1
+#define PRNG_DISTRIBUTION_NORMAL_POLAR  2
+#define PRNG_DISTRIBUTION_LOGNORMAL     3
+#define PRNG_DISTRIBUTION_EXPONENTIAL   4
+#define PRNG_DISTRIBUTION_POISSON       5
+#define PRNG_DISTRIBUTION_GAMMA         6
+
+#ifndef PRNG_DISTRIBUTION
+#define PRNG_DISTRIBUTION   PRNG_DISTRIBUTION_UNIFORM   // uniform distribution by default
+#endif
+#ifndef PRNG_NORMAL_MEAN
+#define PRNG_NORMAL_MEAN    0.0f
+#endif
+#ifndef PRNG_NORMAL_SIGMA
+#define PRNG_NORMAL_SIGMA   1.0f
+#endif
+#ifndef PRNG_LAMBDA
+#define PRNG_LAMBDA         1.0f
+#endif
+#ifndef PRNG_POISSON_EXP_LAMBDA
+#define PRNG_POISSON_EXP_LAMBDA 0.367879441f            // exp(-PRNG_LAMBDA)
+#endif
+#ifndef PRNG_GAMMA_D
+#define PRNG_GAMMA_D        0.666666667f                // shape-1/3 (shape=1)
+#endif
+#ifndef PRNG_GAMMA_C
+#define PRNG_GAMMA_C        0.408248290f                // 1/sqrt(9*PRNG_GAMMA_D)
+#endif
+#ifndef PRNG_GAMMA_SCALE
+#define PRNG_GAMMA_SCALE    1.0f
+#endif
+
+#define PRNG_OUTPUT_FLOAT       0
+#define PRNG_OUTPUT_UINT32      1
+#define PRNG_OUTPUT_UINT64      2
+
+#ifndef PRNG_OUTPUT
+#define PRNG_OUTPUT         PRNG_OUTPUT_FLOAT           // hgpu_float4 output by default
+#endif
+
+#if (PRNG_OUTPUT==PRNG_OUTPUT_UINT32)
+#define prng_output_t       uint4
+#elif (PRNG_OUTPUT==PRNG_OUTPUT_UINT64)
+#define prng_output_t       ulong2
+#else
+#define prng_output_t       hgpu_float4
+#endif
+
+#if (PRNG_OUTPUT!=PRNG_OUTPUT_FLOAT) && !defined(PRNG_HAS_NEXT_UINT4)
+    #error "integer output is supported only by PRNGs with integer output type"
+#endif
+
+#define PRNG_DISTRIBUTION_2PI     (6.283185307179586476925286766559)
+#define PRNG_DISTRIBUTION_MIN_FP  (5.42101086242752217003726400434970855712890625E-20) // 1/2^64 (to avoid log(0))
+#define PRNG_POISSON_MAX_K        1024      // upper bound of Poisson PRNs produced by inversion
+
+#if (PRNG_DISTRIBUTION==PRNG_DISTRIBUTION_NORMAL_POLAR) || (PRNG_DISTRIBUTION==PRNG_DISTRIBUTION_GAMMA) || \
+   ((PRNG_DISTRIBUTION==PRNG_DISTRIBUTION_POISSON) && defined(PRNG_POISSON_LARGE))
+#define PRNG_DISTRIBUTION_REJECTION         // distribution is produced by rejection sampling
+#endif
+
+//________________________________________________________________________________________________________ Box-Muller transform
+__attribute__((always_inline)) hgpu_float4
+prng_box_muller_float4(hgpu_float4 u)
+{
+#pragma OPENCL FP_CONTRACT OFF
+    hgpu_float4 result;
+    hgpu_float2 r = sqrt(((hgpu_float) -2.0) * log(max(u.xz,(hgpu_float2) PRNG_DISTRIBUTION_MIN_FP)));
+    hgpu_float2 t = ((hgpu_float) PRNG_DISTRIBUTION_2PI) * u.yw;
+    result.xz = r * cos(t);
+    result.yw = r * sin(t);
+    return result;
+}
+
+__attribute__((always_inline)) hgpu_float4
+prng_normal_float4(hgpu_float4 u)
+{
+#pragma OPENCL FP_CONTRACT OFF
+    return ((hgpu_float) PRNG_NORMAL_MEAN) + ((hgpu_float) PRNG_NORMAL_SIGMA) * prng_box_muller_float4(u);
+}
+
+//________________________________________________________________________________________________________ exponential distribution
+__attribute__((always_inline)) hgpu_float4
+prng_exponential_float4(hgpu_float4 u)
+{
+#pragma OPENCL FP_CONTRACT OFF
+    return -log(max(u,(hgpu_float4) PRNG_DISTRIBUTION_MIN_FP)) / ((hgpu_float) PRNG_LAMBDA);
+}
+
+//________________________________________________________________________________________________________ Poisson distribution (inversion)
+__attribute__((always_inline)) hgpu_float4
+prng_poisson_inversion_float4(hgpu_float4 u)
+{
+#pragma OPENCL FP_CONTRACT OFF
+    hgpu_float4 k = (hgpu_float4) 0;
+    hgpu_float  p = (hgpu_float) PRNG_POISSON_EXP_LAMBDA;
+    hgpu_float  F = p;
+    // cumulative probability F is the same for all lanes, so lanes step together;
+    // F could saturate below u due to rounding, so search stops when probability p underflows to 0
+    for (uint n = 1; (n < PRNG_POISSON_MAX_K) && (p > (hgpu_float) 0.0) && any(u > (hgpu_float4) F); n++) {
+        k = select(k,k + (hgpu_float) 1.0,u > (hgpu_float4) F);
+        p = p * ((hgpu_float) PRNG_LAMBDA) / ((hgpu_float) n);
+        F = F + p;
+    }
+    return k;
+}
+
+//________________________________________________________________________________________________________ rejection samplers
+// every sampler takes uniform PRNs of one candidate, writes accepted PRNs to values and returns their number
+
+// Marsaglia polar method
+__attribute__((always_inline)) uint
+prng_polar_candidate(hgpu_float u1, hgpu_float u2, hgpu_float* values)
+{
+#pragma OPENCL FP_CONTRACT OFF
+    hgpu_float v1 = u1 * ((hgpu_float) 2.0) - ((hgpu_float) 1.0);
+    hgpu_float v2 = u2 * ((hgpu_float) 2.0) - ((hgpu_float) 1.0);
+    hgpu_float s  = v1 * v1 + v2 * v2;
+    if ((s <= (hgpu_float) 0.0) || (s >= (hgpu_float) 1.0)) return 0;
+    hgpu_float f  = sqrt(((hgpu_float) -2.0) * log(s) / s);
+    values[0] = ((hgpu_float) PRNG_NORMAL_MEAN) + ((hgpu_float) PRNG_NORMAL_SIGMA) * (v1 * f);
+    values[1] = ((hgpu_float) PRNG_NORMAL_MEAN) + ((hgpu_float) PRNG_NORMAL_SIGMA) * (v2 * f);
+    return 2;
+}
+
+#ifdef PRNG_POISSON_LARGE
+// PTRS (transformed rejection with squeeze) method for Poisson distribution with large lambda (W.Hormann, 1993)
+__attribute__((always_inline)) uint
+prng_poisson_ptrs_candidate(hgpu_float u, hgpu_float v, hgpu_float* values)
+{
+#pragma OPENCL FP_CONTRACT OFF
+    hgpu_float U  = u - ((hgpu_float) 0.5);
+    hgpu_float us = ((hgpu_float) 0.5) - fabs(U);
+    if (us <= (hgpu_float) 0.0) return 0;
+    hgpu_float k  = floor((((hgpu_float) 2.0) * ((hgpu_float) PRNG_PTRS_A) / us + ((hgpu_float) PRNG_PTRS_B)) * U +
+                          ((hgpu_float) PRNG_LAMBDA) + ((hgpu_float) 0.43));
+    values[0] = k;
+    if ((us >= (hgpu_float) 0.07) && (v <= (hgpu_float) PRNG_PTRS_VR)) return 1;
+    if ((k < (hgpu_float) 0.0) || ((us < (hgpu_float) 0.013) && (v > us))) return 0;
+    if ((log(v) + ((hgpu_float) PRNG_PTRS_LOG_INV_ALPHA) - log(((hgpu_float) PRNG_PTRS_A) / (us * us) + ((hgpu_float) PRNG_PTRS_B))) <=
+        (k * ((hgpu_float) PRNG_POISSON_LOG_LAMBDA) - ((hgpu_float) PRNG_LAMBDA) - lgamma(k + ((hgpu_float) 1.0)))) return 1;
+    return 0;
+}
+#endif
+
+// Marsaglia-Tsang method for Gamma distribution (x - normal PRN, u - uniform PRN)
+__attribute__((always_inline)) uint
+prng_gamma_candidate(hgpu_float x, hgpu_float u, hgpu_float* values)
+{
+#pragma OPENCL FP_CONTRACT OFF
+    hgpu_float v  = ((hgpu_float) 1.0) + ((hgpu_float) PRNG_GAMMA_C) * x;
+    if (v <= (hgpu_float) 0.0) return 0;
+    v = v * v * v;
+    hgpu_float x2 = x * x;
+    values[0] = ((hgpu_float) PRNG_GAMMA_D) * v * ((hgpu_float) PRNG_GAMMA_SCALE);
+#ifdef PRNG_GAMMA_BOOST
+    // shape<1: Gamma(shape+1) is boosted by U^(1/shape), where U=u*exp(-g) is uniform in (0,1) for accepted candidate
+    hgpu_float g  = ((hgpu_float) 0.5) * x2 + ((hgpu_float) PRNG_GAMMA_D) * (((hgpu_float) 1.0) - v + log(v));
+    if (!(log(u) < g)) return 0;
+    values[0] *= pow(u * exp(-g),(hgpu_float) PRNG_GAMMA_BOOST);
+    return 1;
+#else
+    if (u < ((hgpu_float) 1.0) - ((hgpu_float) 0.0331) * (x2 * x2)) return 1;
+    hgpu_float g  = ((hgpu_float) 0.5) * x2 + ((hgpu_float) PRNG_GAMMA_D) * (((hgpu_float) 1.0) - v + log(v));
+    return (log(u) < g) ? 1 : 0;
+#endif
+}
+
+#ifdef PRNG_DISTRIBUTION_REJECTION
+// two candidates per hgpu_float4 of uniform PRNs, returns number of accepted PRNs (up to 4)
+__attribute__((always_inline)) uint
+prng_candidates_float4(hgpu_float4 u, hgpu_float* values)
+{
+#pragma OPENCL FP_CONTRACT OFF
+    uint n = 0;
+#if (PRNG_DISTRIBUTION==PRNG_DISTRIBUTION_NORMAL_POLAR)
+    n += prng_polar_candidate(u.x,u.y,values + n);
+    n += prng_polar_candidate(u.z,u.w,values + n);
+#elif (PRNG_DISTRIBUTION==PRNG_DISTRIBUTION_POISSON)
+    n += prng_poisson_ptrs_candidate(u.x,u.y,values + n);
+    n += prng_poisson_ptrs_candidate(u.z,u.w,values + n);
+#elif (PRNG_DISTRIBUTION==PRNG_DISTRIBUTION_GAMMA)
+    // normal PRNs for both candidates are made by Box-Muller transform of (x,y)
+    hgpu_float r = sqrt(((hgpu_float) -2.0) * log(max(u.x,(hgpu_float) PRNG_DISTRIBUTION_MIN_FP)));
+    hgpu_float t = ((hgpu_float) PRNG_DISTRIBUTION_2PI) * u.y;
+    n += prng_gamma_candidate(r * cos(t),u.z,values + n);
+    n += prng_gamma_candidate(r * sin(t),u.w,values + n);
+#endif
+    return n;
+}
+
+// next hgpu_float4 of PRNs by rejection sampling (PRNs accepted in excess of four are dropped)
+__attribute__((always_inline)) hgpu_float4
+prng_next_rejection_float4(prng_state* state)
+{
+    hgpu_float values[8];
+    uint n = 0;
+    while (n < 4)
+        n += prng_candidates_float4(prng_next_float4(state),values + n);
+    return (hgpu_float4) (values[0], values[1], values[2], values[3]);
+}
+#endif
+
+//________________________________________________________________________________________________________ PRNs in distribution
+__attribute__((always_inline)) hgpu_float4
+prng_next_normal_float4(prng_state* state)
+{
+#if (PRNG_DISTRIBUTION==PRNG_DISTRIBUTION_NORMAL_POLAR)
+    return prng_next_rejection_float4(state);
+#else
+    return prng_normal_float4(prng_next_float4(state));
+#endif
+}
+
+__attribute__((always_inline)) hgpu_float4
+prng_next_lognormal_float4(prng_state* state)
+{
+    return exp(prng_next_normal_float4(state));
+}
+
+__attribute__((always_inline)) hgpu_float4
+prng_next_output_float4(prng_state* state)
+{
+#if ((PRNG_DISTRIBUTION==PRNG_DISTRIBUTION_NORMAL) || (PRNG_DISTRIBUTION==PRNG_DISTRIBUTION_NORMAL_POLAR))
+    return prng_next_normal_float4(state);
+#elif (PRNG_DISTRIBUTION==PRNG_DISTRIBUTION_LOGNORMAL)
+    return prng_next_lognormal_float4(state);
+#elif (PRNG_DISTRIBUTION==PRNG_DISTRIBUTION_EXPONENTIAL)
+    return prng_exponential_float4(prng_next_float4(state));
+#elif (PRNG_DISTRIBUTION==PRNG_DISTRIBUTION_POISSON) && !defined(PRNG_POISSON_LARGE)
+    return prng_poisson_inversion_float4(prng_next_float4(state));
+#elif defined(PRNG_DISTRIBUTION_REJECTION)
+    return prng_next_rejection_float4(state);
+#else
+    return prng_next_float4(state);
+#endif
+}
+
+// work-item GID writes N prng_output_t of PRNs to randoms[GID + i*GID_SIZE]
+__attribute__((always_inline)) void
+prng_produce(__global prng_output_t* randoms, prng_state* state, const uint N)
+{
+    uint giddst = GID;
+#if (PRNG_OUTPUT==PRNG_OUTPUT_UINT32)
+    for (uint i = 0; i < N; i++) {
+        randoms[giddst] = prng_next_uint4(state);
+        giddst += GID_SIZE;
+    }
+#elif (PRNG_OUTPUT==PRNG_OUTPUT_UINT64)
+    for (uint i = 0; i < N; i++) {
+        uint4 rnd = prng_next_uint4(state);
+        randoms[giddst] = (ulong2) (upsample(rnd.x,rnd.y), upsample(rnd.z,rnd.w));
+        giddst += GID_SIZE;
+    }
+#elif defined(PRNG_DISTRIBUTION_REJECTION)
+    // rejection loop is flattened: every pass draws one hgpu_float4 of candidates and queues accepted PRNs,
+    // so work-items of a wavefront do not wait in nested per-PRN loops for the unluckiest one;
+    // PRNs of one stream come out in the same order as from prng_candidates_float4 (nothing is dropped)
+    hgpu_float queue[8];
+    uint queued = 0;
+    uint i = 0;
+    while (i < N) {
+        queued += prng_candidates_float4(prng_next_float4(state),queue + queued);
+        if (queued >= 4) {
+            randoms[giddst] = (hgpu_float4) (queue[0], queue[1], queue[2], queue[3]);
+            giddst += GID_SIZE;
+            i++;
+            queued -= 4;
+            for (uint j = 0; j < queued; j++) queue[j] = queue[j + 4];
+        }
+    }
+#else
+    for (uint i = 0; i < N; i++) {
+        randoms[giddst] = prng_next_output_float4(state);
+        giddst += GID_SIZE;
+    }
+#endif
+}
+
+
+#endif
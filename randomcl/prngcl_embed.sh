@@ -0,0 +1,44 @@
+#!/bin/sh
+# generates C++ source with OpenCL-files embedded as string constants (see HGPU_PRNG_source_get_embedded)
+# #include-s of .cl-files are inlined (each file once - all .cl-files are guarded), so no include paths are needed
+#
+# usage: prngcl_embed.sh output.cpp file1.cl [file2.cl ...]
+# (names of files are the same as used for PRNG descriptions, i.e. relative to root path)
+
+output=$1
+shift
+
+{
+    echo "// generated by randomcl/prngcl_embed.sh from OpenCL-files - do not edit"
+    echo "#include \"hgpu_prng.h\""
+    echo ""
+    echo "const HGPU_PRNG_embedded_source HGPU_PRNG_embedded_sources[] = {"
+    for file in "$@"; do
+        echo "    {\"$file\","
+        awk -v root="$file" '
+            function embed(file,   dir, line, include_file) {
+                embedded[file] = 1
+                dir = file
+                if (!sub(/\/[^\/]*$/,"",dir)) dir = "."
+                while ((getline line < file) > 0) {
+                    sub(/\r$/,"",line)
+                    if (line ~ /^[ \t]*#[ \t]*include[ \t]*"[^"]*\.cl"/) {
+                        include_file = line
+                        sub(/^[^"]*"/,"",include_file)
+                        sub(/".*$/,"",include_file)
+                        include_file = dir "/" include_file
+                        if (!(include_file in embedded)) embed(include_file)
+                        continue
+                    }
+                    gsub(/\\/,"\\\\",line)
+                    gsub(/"/,"\\\"",line)
+                    printf("     \"%s\\n\"\n",line)
+                }
+                close(file)
+            }
+            BEGIN { embed(root) }'
+        echo "    },"
+    done
+    echo "    {NULL,NULL}"
+    echo "};"
+} > "$output"
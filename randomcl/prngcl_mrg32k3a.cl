@@ -46,6 +46,7 @@
 #define PRNGCL_MRG32K3A_CL
 
 #include "prngcl_common.cl"
+#include "prngcl_skip.cl"
 
 #define MRG32k3a_min    (1.0/4294967088.0)
 #define MRG32k3a_max    (4294967087.0/4294967088.0)
@@ -59,6 +60,10 @@
 #define MRG32k3a_a21   527612L
 #define MRG32k3a_a22   1370589L
 
+// transition matrices of MRG32k3a components: (s0,s1,s2) -> (s1,s2,x_new)
+__constant uint MRG32k3a_A1[9] = {0, 1, 0,   0, 0, 1,   MRG32k3a_m1 - MRG32k3a_a12, MRG32k3a_a11, 0};
+__constant uint MRG32k3a_A2[9] = {0, 1, 0,   0, 0, 1,   MRG32k3a_m2 - MRG32k3a_a22, 0, MRG32k3a_a21};
+
 //________________________________________________________________________________________________________ MRG32k3a PRNG
 __attribute__((always_inline)) void
 mrg32k3a_step(uint4* seed1,uint4* seed2,float* rnd)
@@ -103,46 +108,73 @@ mrg32k3a_step_double(uint4* seed1,uint4* seed2)
 }
 #endif
 
-__kernel void
-mrg32k3a(__global uint4* seed_table, 
-         __global hgpu_float4* randoms,
-            const uint N)
+typedef struct _mrg32k3a_state {
+    uint4 seed1;
+    uint4 seed2;
+} mrg32k3a_state;
+
+__attribute__((always_inline)) mrg32k3a_state
+mrg32k3a_state_load(__global uint4* seed_table)
 {
-    uint giddst = GID;
-#ifdef PRECISION_DOUBLE  // if double precision is defined
-    float rnd;
+    mrg32k3a_state state;
+    state.seed1 = seed_table[GID];
+    state.seed2 = seed_table[GID + GID_SIZE];
+    return state;
+}
+
+__attribute__((always_inline)) void
+mrg32k3a_state_store(__global uint4* seed_table,mrg32k3a_state* state)
+{
+    seed_table[GID] = (*state).seed1;
+    seed_table[GID + GID_SIZE] = (*state).seed2;
+}
+
+__attribute__((always_inline)) hgpu_float4
+mrg32k3a_next_float4(mrg32k3a_state* state)
+{
+#ifdef PRECISION_DOUBLE // if double precision is defined
+    // MRG32k3a PRNG returns values [1;4294967087]/4294967088, or (0.0;1.0)
     hgpu_double4 result;
+    result.x = mrg32k3a_step_double(&(*state).seed1,&(*state).seed2);
+    result.y = mrg32k3a_step_double(&(*state).seed1,&(*state).seed2);
+    result.z = mrg32k3a_step_double(&(*state).seed1,&(*state).seed2);
+    result.w = mrg32k3a_step_double(&(*state).seed1,&(*state).seed2);
+    return result;
 #else
     float rnd;
     float4 result;
+    mrg32k3a_step(&(*state).seed1,&(*state).seed2,&rnd);
+        result.x = rnd;
+    mrg32k3a_step(&(*state).seed1,&(*state).seed2,&rnd);
+        result.y = rnd;
+    mrg32k3a_step(&(*state).seed1,&(*state).seed2,&rnd);
+        result.z = rnd;
+    mrg32k3a_step(&(*state).seed1,&(*state).seed2,&rnd);
+        result.w = rnd;
+    return result;
 #endif
+}
 
-    uint4 seed1 = seed_table[GID];
-    uint4 seed2 = seed_table[GID + GID_SIZE];
+#include "prngcl_distribution.cl"
 
-    for (uint i = 0; i < N; i++) {
-#ifdef PRECISION_DOUBLE // if double precision is defined
-        // MRG32k3a PRNG returns values [1;4294967087]/4294967088, or (0.0;1.0)
-        result.x = mrg32k3a_step_double(&seed1,&seed2);
-        result.y = mrg32k3a_step_double(&seed1,&seed2);
-        result.z = mrg32k3a_step_double(&seed1,&seed2);
-        result.w = mrg32k3a_step_double(&seed1,&seed2);
-        randoms[giddst] = result;
-#else
-        mrg32k3a_step(&seed1,&seed2,&rnd);
-            result.x = rnd;
-        mrg32k3a_step(&seed1,&seed2,&rnd);
-            result.y = rnd;
-        mrg32k3a_step(&seed1,&seed2,&rnd);
-            result.z = rnd;
-        mrg32k3a_step(&seed1,&seed2,&rnd);
-            result.w = rnd;
-        randoms[giddst] = result;
-#endif
-        giddst += GID_SIZE;
-    }
-    seed_table[GID] = seed1;
-    seed_table[GID + GID_SIZE] = seed2;
+__kernel void
+mrg32k3a(__global uint4* seed_table, 
+         __global prng_output_t* randoms,
+            const uint N)
+{
+    mrg32k3a_state state = mrg32k3a_state_load(seed_table);
+    prng_produce(randoms,&state,N);
+    mrg32k3a_state_store(seed_table,&state);
+}
+
+__kernel void
+mrg32k3a_skip(__global uint4* seed_table,
+                const ulong n,
+                const ulong stride)
+{
+    ulong skip = n + stride * GID;
+    seed_table[GID]            = hgpu_skip_matrix_powmod(MRG32k3a_A1, skip, MRG32k3a_m1, seed_table[GID]);
+    seed_table[GID + GID_SIZE] = hgpu_skip_matrix_powmod(MRG32k3a_A2, skip, MRG32k3a_m2, seed_table[GID + GID_SIZE]);
 }
 
 #endif
@@ -65,12 +65,17 @@
 #define HGPU_PRNG_MRG32K3A_a21     527612LL
 #define HGPU_PRNG_MRG32K3A_a22     1370589LL
 
+// transition matrices of MRG32k3a components: (s0,s1,s2) -> (s1,s2,x_new)
+static const u32_T HGPU_PRNG_MRG32K3A_A1[9] = {0, 1, 0,   0, 0, 1,   HGPU_PRNG_MRG32K3A_m1 - HGPU_PRNG_MRG32K3A_a12, HGPU_PRNG_MRG32K3A_a11, 0};
+static const u32_T HGPU_PRNG_MRG32K3A_A2[9] = {0, 1, 0,   0, 0, 1,   HGPU_PRNG_MRG32K3A_m2 - HGPU_PRNG_MRG32K3A_a22, 0, HGPU_PRNG_MRG32K3A_a21};
+
     typedef struct {
           unsigned int  seeds[6];
     } HGPU_PRNG_MRG32K3A_state_t;
 
             static void   HGPU_PRNG_MRG32K3A_initialize(void* PRNG_state, unsigned int PRNG_randseries);
     static unsigned int   HGPU_PRNG_MRG32K3A_produce_one_uint_CPU(void* PRNG_state);
+            static void   HGPU_PRNG_MRG32K3A_skip_CPU(void* PRNG_state,u64_T n);
             static void   HGPU_PRNG_MRG32K3A_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters);
 
 inline double
@@ -130,20 +135,35 @@ HGPU_PRNG_MRG32K3A_produce_one_double_CPU(void* PRNG_state){
     return (result * HGPU_PRNG_MRG32K3A_m);
 }
 
+static void
+HGPU_PRNG_MRG32K3A_skip_CPU(void* PRNG_state,u64_T n){
+    HGPU_PRNG_MRG32K3A_state_t* state = (HGPU_PRNG_MRG32K3A_state_t*) PRNG_state;
+    u32_T A1_n[9], A2_n[9];
+    u64_T s[6];
+
+    HGPU_PRNG_skip_matrix_powmod(HGPU_PRNG_MRG32K3A_A1,n,HGPU_PRNG_MRG32K3A_m1,A1_n);
+    HGPU_PRNG_skip_matrix_powmod(HGPU_PRNG_MRG32K3A_A2,n,HGPU_PRNG_MRG32K3A_m2,A2_n);
+    for (int i=0; i<3; i++) {
+        s[i]   = (((u64_T) A1_n[3*i]) * state->seeds[0]) % HGPU_PRNG_MRG32K3A_m1;
+        s[i]  += (((u64_T) A1_n[3*i+1]) * state->seeds[1]) % HGPU_PRNG_MRG32K3A_m1;
+        s[i]  += (((u64_T) A1_n[3*i+2]) * state->seeds[2]) % HGPU_PRNG_MRG32K3A_m1;
+        s[i+3] = (((u64_T) A2_n[3*i]) * state->seeds[3]) % HGPU_PRNG_MRG32K3A_m2;
+        s[i+3]+= (((u64_T) A2_n[3*i+1]) * state->seeds[4]) % HGPU_PRNG_MRG32K3A_m2;
+        s[i+3]+= (((u64_T) A2_n[3*i+2]) * state->seeds[5]) % HGPU_PRNG_MRG32K3A_m2;
+    }
+    for (int i=0; i<3; i++) {
+        state->seeds[i]   = (unsigned int) (s[i]   % HGPU_PRNG_MRG32K3A_m1);
+        state->seeds[i+3] = (unsigned int) (s[i+3] % HGPU_PRNG_MRG32K3A_m2);
+    }
+}
+
 static void
 HGPU_PRNG_MRG32K3A_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters){
     HGPU_PRNG_MRG32K3A_state_t* state = (HGPU_PRNG_MRG32K3A_state_t*) PRNG_state;
 
     size_t seed_table_size         = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * 2);
-    size_t randoms_size            = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * PRNG_parameters->samples);
-    cl_uint4*  PRNG_seed_table_uint4 = (cl_uint4*)  calloc(seed_table_size,sizeof(cl_uint4));
-    cl_float4*  PRNG_randoms         = NULL;
-    cl_double4* PRNG_randoms_double  = NULL;
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        PRNG_randoms_double = (cl_double4*) calloc(randoms_size,sizeof(cl_double4));
-    else
-        PRNG_randoms        = (cl_float4*)  calloc(randoms_size,sizeof(cl_float4));
-    if ((!PRNG_seed_table_uint4) || ((!PRNG_randoms_double) && (!PRNG_randoms)))
+    cl_uint4*  PRNG_seed_table_uint4 = (cl_uint4*)  HGPU_GPU_context_buffer_host_alloc(context,seed_table_size,sizeof(cl_uint4));
+    if ((!PRNG_seed_table_uint4))
         HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for randoms");
 
     for (size_t i=0; i<(seed_table_size>>1); ++i) {
@@ -168,17 +188,19 @@ HGPU_PRNG_MRG32K3A_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG
     PRNG_seed_table_uint4[PRNG_parameters->instances].s[1] = state->seeds[4];
     PRNG_seed_table_uint4[PRNG_parameters->instances].s[2] = state->seeds[5];
 
+    if (PRNG_parameters->substream)     // substreams of CPU stream are set by skip-ahead kernel
+        for (unsigned int i=1; i<PRNG_parameters->instances; i++) {
+            PRNG_seed_table_uint4[i] = PRNG_seed_table_uint4[0];
+            PRNG_seed_table_uint4[PRNG_parameters->instances + i] = PRNG_seed_table_uint4[PRNG_parameters->instances];
+        }
+
     unsigned int seed_table_id = 0;
     unsigned int randoms_id = 0;
 
     seed_table_id = HGPU_GPU_context_buffer_init(context,PRNG_seed_table_uint4,HGPU_GPU_buffer_type_io,seed_table_size,sizeof(cl_uint4));
     HGPU_GPU_context_buffer_set_name(context,seed_table_id,(char*) "(MRG32K3A) PRNG_seed_table");
 
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms_double,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_double4));
-    else
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_float4));
-    HGPU_GPU_context_buffer_set_name(context,randoms_id,(char*) "(MRG32K3A) PRNG_randoms");
+    randoms_id = HGPU_PRNG_GPU_randoms_init(context,PRNG_parameters,"(MRG32K3A) PRNG_randoms");
 
     PRNG_parameters->id_buffer_input_seeds = HGPU_GPU_MAX_BUFFERS;
     PRNG_parameters->id_buffer_seeds       = seed_table_id;
@@ -200,12 +222,14 @@ HGPU_PRNG_MRG32K3A_description = {
         NULL,                                         // PRNG additional parameters initialization
         &HGPU_PRNG_MRG32K3A_produce_one_uint_CPU,     // PRNG production one unsigned integer
         &HGPU_PRNG_MRG32K3A_produce_one_double_CPU,   // PRNG production one double
+        &HGPU_PRNG_MRG32K3A_skip_CPU,                 // PRNG skip-ahead
         //
         &HGPU_PRNG_MRG32K3A_init_GPU,                 // PRNG init for GPU procedure
         NULL,                                         // PRNG additional compilation options
         HGPU_PRNG_CL_FILE,                            // PRNG source codes
         NULL,                                         // PRNG init kernel
-        "mrg32k3a"                                    // PRNG production kernel
+        "mrg32k3a",                                   // PRNG production kernel
+        "mrg32k3a_skip"                               // PRNG skip-ahead kernel
 };
 
 const HGPU_PRNG_description*  HGPU_PRNG_MRG32K3A = &HGPU_PRNG_MRG32K3A_description;
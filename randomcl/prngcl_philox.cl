@@ -0,0 +1,276 @@
+/******************************************************************************
+ * @file     prngcl_philox.cl
+ * @author   Vadim Demchik <vadimdi@yahoo.com>
+ * @version  1.1.2
+ *
+ * @brief    [PRNGCL library]
+ *           contains OpenCL implementation of Philox4x32-10 counter-based pseudo-random number generator
+ *
+ *
+ * @section  CREDITS
+ *
+ *   John K. Salmon, Mark A. Moraes, Ron O. Dror, and David E. Shaw,
+ *   "Parallel random numbers: as easy as 1, 2, 3",
+ *   Proceedings of the International Conference for High Performance Computing,
+ *   Networking, Storage and Analysis (SC'11), 2011, 16:1--16:12.
+ *
+ *
+ * @section  LICENSE
+ *
+ * Copyright (c) 2013-2015 Vadim Demchik
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *    Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *****************************************************************************/
+
+#ifndef PRNGCL_PHILOX_CL
+#define PRNGCL_PHILOX_CL
+
+#include "prngcl_common.cl"
+
+#define PHILOX_m_FP   (4294967296.0f)
+#define PHILOX_min    0
+#define PHILOX_max    4294967295
+#define PHILOX_min_FP (0.0)
+#define PHILOX_max_FP (4294967295.0/4294967296.0)
+#define PHILOX_k      (2.3283064365386962890625E-10) // 1/2^32
+
+#define PHILOX_M0     0xD2511F53    // Philox4x32 multipliers
+#define PHILOX_M1     0xCD9E8D57
+#define PHILOX_W0     0x9E3779B9    // Weyl sequence key increments
+#define PHILOX_W1     0xBB67AE85
+
+// counter table layout: key (2 words), SEED4, finished work-items counter,
+// offset of all instances in their streams (2 words), stride between GIDs (2 words), global index of the first instance,
+// maximal number of PRNs consumed by work-item in current production call
+#define PHILOX_TABLE_KEY0       0
+#define PHILOX_TABLE_KEY1       1
+#define PHILOX_TABLE_SEED4      2
+#define PHILOX_TABLE_FINISHED   3
+#define PHILOX_TABLE_OFFSET_LO  4
+#define PHILOX_TABLE_OFFSET_HI  5
+#define PHILOX_TABLE_STRIDE_LO  6
+#define PHILOX_TABLE_STRIDE_HI  7
+#define PHILOX_TABLE_BASE       8
+#define PHILOX_TABLE_CONSUMED   9
+
+typedef struct _philox_state {
+    uint4 counter;      // (block index low, stream index, block index high, SEED4)
+    uint4 block;        // last produced block of 4 PRNs
+    uint2 key;          // key (randseries-dependent)
+    uint  index;        // index of next unused PRN in block
+    ulong start;        // position in stream at state load
+} philox_state;
+
+//________________________________________________________________________________________________________ PHILOX PRNG
+__attribute__((always_inline)) uint4
+philox_round(uint4 counter, uint2 key)
+{
+    uint4 result;
+    uint hi0 = mul_hi((uint) PHILOX_M0, counter.x);
+    uint hi1 = mul_hi((uint) PHILOX_M1, counter.z);
+
+    result.x = hi1 ^ counter.y ^ key.x;
+    result.y = PHILOX_M1 * counter.z;
+    result.z = hi0 ^ counter.w ^ key.y;
+    result.w = PHILOX_M0 * counter.x;
+
+    return result;
+}
+
+__attribute__((always_inline)) uint4
+philox4x32_10(uint4 counter, uint2 key)
+{
+    uint4 result = counter;
+    uint2 k = key;
+    const uint2 w = (uint2) (PHILOX_W0, PHILOX_W1);
+
+    result = philox_round(result, k);  k += w;  // round 1
+    result = philox_round(result, k);  k += w;  // round 2
+    result = philox_round(result, k);  k += w;  // round 3
+    result = philox_round(result, k);  k += w;  // round 4
+    result = philox_round(result, k);  k += w;  // round 5
+    result = philox_round(result, k);  k += w;  // round 6
+    result = philox_round(result, k);  k += w;  // round 7
+    result = philox_round(result, k);  k += w;  // round 8
+    result = philox_round(result, k);  k += w;  // round 9
+    result = philox_round(result, k);           // round 10
+
+    return result;
+}
+
+__attribute__((always_inline)) uint4
+philox_step(philox_state* state)
+{
+    uint4 result = philox4x32_10((*state).counter, (*state).key);
+    (*state).counter.x++;
+    if (!(*state).counter.x) (*state).counter.z++;
+    return result;
+}
+
+__attribute__((always_inline)) uint
+philox_step_uint(philox_state* state)
+{
+    uint result;
+    if ((*state).index > 3) {
+        (*state).block = philox_step(state);
+        (*state).index = 0;
+    }
+    uint i = (*state).index++;
+    result = (i == 0) ? (*state).block.x :
+             (i == 1) ? (*state).block.y :
+             (i == 2) ? (*state).block.z : (*state).block.w;
+    return result;
+}
+
+__attribute__((always_inline)) uint4
+philox_step_uint4(philox_state* state)
+{
+    uint4 result;
+    if ((*state).index > 3) {
+        result = philox_step(state);
+    } else {    // continue partially used block (after skip-ahead)
+        result.x = philox_step_uint(state);
+        result.y = philox_step_uint(state);
+        result.z = philox_step_uint(state);
+        result.w = philox_step_uint(state);
+    }
+    return result;
+}
+
+#ifdef PRECISION_DOUBLE  // if double precision is defined
+__attribute__((always_inline)) hgpu_double
+philox_step_double(philox_state* state)
+{
+    hgpu_double result;
+    uint rnd1 = 0;
+    uint rnd2 = 0;
+#ifndef PRNG_SKIP_CHECK
+    while ((rnd1 <= PHILOX_min) || (rnd1 >= PHILOX_max))
+#endif
+    {
+        rnd1 = philox_step_uint(state);
+    }
+    rnd2 = philox_step_uint(state);
+
+    result = hgpu_uint_to_double(rnd1,rnd2,PHILOX_min,PHILOX_max,PHILOX_k);
+    return result;
+}
+#endif
+
+// position of next PRN in stream (4*block index + index in block)
+__attribute__((always_inline)) ulong
+philox_position(philox_state* state)
+{
+    ulong block = upsample((*state).counter.z, (*state).counter.x);
+    return ((*state).index > 3) ? (block << 2) : (((block - 1) << 2) + (*state).index);
+}
+
+// state is computed from counter table: position of GID in its stream is (offset + stride*GID);
+// substreams (stride>0) are parts of the same stream 0 (as on CPU), otherwise every instance has its own stream (base + GID)
+__attribute__((always_inline)) philox_state
+philox_state_load(__global uint* counter_table)
+{
+    ulong offset   = upsample(counter_table[PHILOX_TABLE_OFFSET_HI], counter_table[PHILOX_TABLE_OFFSET_LO]);
+    ulong stride   = upsample(counter_table[PHILOX_TABLE_STRIDE_HI], counter_table[PHILOX_TABLE_STRIDE_LO]);
+    ulong position = offset + stride * GID;
+    ulong block    = position >> 2;
+    uint  stream   = (stride) ? 0 : (counter_table[PHILOX_TABLE_BASE] + (uint) GID);
+    philox_state state;
+    state.key     = (uint2) (counter_table[PHILOX_TABLE_KEY0], counter_table[PHILOX_TABLE_KEY1]);
+    state.counter = (uint4) ((uint) block, stream, (uint) (block >> 32), counter_table[PHILOX_TABLE_SEED4]);
+    state.block   = (uint4) 0;
+    state.index   = 4;
+    state.start   = position;
+    if (position & 3) {   // start inside of block
+        state.block = philox_step(&state);
+        state.index = (uint) (position & 3);
+    }
+    return state;
+}
+
+// nothing is stored per work-item: the last finished work-item advances shared offset by maximal number of consumed PRNs,
+// so every GPU position stays CPU position after skip-ahead (see HGPU_PRNG_skip)
+__attribute__((always_inline)) void
+philox_state_store(__global uint* counter_table,philox_state* state)
+{
+    atomic_max(&counter_table[PHILOX_TABLE_CONSUMED], (uint) (philox_position(state) - (*state).start));
+    mem_fence(CLK_GLOBAL_MEM_FENCE);
+    if (atomic_inc(&counter_table[PHILOX_TABLE_FINISHED]) == (uint) (GID_SIZE - 1)) {
+        ulong offset = upsample(counter_table[PHILOX_TABLE_OFFSET_HI], counter_table[PHILOX_TABLE_OFFSET_LO]) +
+                       atomic_xchg(&counter_table[PHILOX_TABLE_CONSUMED], 0);
+        counter_table[PHILOX_TABLE_OFFSET_LO] = (uint) offset;
+        counter_table[PHILOX_TABLE_OFFSET_HI] = (uint) (offset >> 32);
+        atomic_xchg(&counter_table[PHILOX_TABLE_FINISHED], 0);
+    }
+}
+
+__attribute__((always_inline)) uint4
+philox_next_uint4(philox_state* state)
+{
+    return philox_step_uint4(state);
+}
+
+__attribute__((always_inline)) hgpu_float4
+philox_next_float4(philox_state* state)
+{
+#ifdef PRECISION_DOUBLE  // if double precision is defined
+    hgpu_double4 result;
+    result.x = philox_step_double(state);
+    result.y = philox_step_double(state);
+    result.z = philox_step_double(state);
+    result.w = philox_step_double(state);
+    return result;
+#else
+    return hgpu_uint4_to_float4(philox_next_uint4(state)) / ((float4) PHILOX_m_FP);
+#endif
+}
+
+#include "prngcl_distribution.cl"
+
+__kernel void
+philox(__global uint* counter_table,
+                     __global prng_output_t* randoms,
+                     const uint N)
+{
+    philox_state state = philox_state_load(counter_table);
+    prng_produce(randoms,&state,N);
+    philox_state_store(counter_table,&state);
+}
+
+// skip-ahead only moves shared offset and stride (skip-ahead of counter-based PRNG is arithmetic)
+__kernel void
+philox_skip(__global uint* counter_table,
+                     const ulong n,
+                     const ulong stride)
+{
+    if (GID) return;
+    ulong offset     = upsample(counter_table[PHILOX_TABLE_OFFSET_HI], counter_table[PHILOX_TABLE_OFFSET_LO]) + n;
+    ulong gid_stride = upsample(counter_table[PHILOX_TABLE_STRIDE_HI], counter_table[PHILOX_TABLE_STRIDE_LO]) + stride;
+    counter_table[PHILOX_TABLE_OFFSET_LO] = (uint) offset;
+    counter_table[PHILOX_TABLE_OFFSET_HI] = (uint) (offset >> 32);
+    counter_table[PHILOX_TABLE_STRIDE_LO] = (uint) gid_stride;
+    counter_table[PHILOX_TABLE_STRIDE_HI] = (uint) (gid_stride >> 32);
+}
+
+#endif
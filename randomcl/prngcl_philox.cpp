@@ -0,0 +1,234 @@
+/******************************************************************************
+ * @file     prngcl_philox.cpp
+ * @author   Vadim Demchik <vadimdi@yahoo.com>
+ * @version  1.1.2
+ *
+ * @brief    [PRNGCL library]
+ *           contains implementation, description and initialization procedures of
+ *           Philox4x32-10 counter-based pseudo-random number generator
+ *
+ *
+ * @section  CREDITS
+ *
+ *   John K. Salmon, Mark A. Moraes, Ron O. Dror, and David E. Shaw,
+ *   "Parallel random numbers: as easy as 1, 2, 3",
+ *   Proceedings of the International Conference for High Performance Computing,
+ *   Networking, Storage and Analysis (SC'11), 2011, 16:1--16:12.
+ *
+ *
+ * @section  LICENSE
+ *
+ * Copyright (c) 2013-2015 Vadim Demchik
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *    Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *****************************************************************************/
+
+#include "hgpu_prng.h"
+
+#define HGPU_PRNG_CL_FILE       PRNGCL_ROOT_PATH "prngcl_philox.cl"
+
+#define HGPU_PRNG_PHILOX_m      (4294967296.0)                 // 2^32
+#define HGPU_PRNG_PHILOX_min    0
+#define HGPU_PRNG_PHILOX_max    4294967295                     // 2^32-1
+#define HGPU_PRNG_PHILOX_min_FP (0.0)
+#define HGPU_PRNG_PHILOX_max_FP (4294967295.0/4294967296.0)
+#define HGPU_PRNG_PHILOX_k      (2.3283064365386962890625E-10) // 1/2^32
+
+#define HGPU_PRNG_PHILOX_M0     0xD2511F53                     // Philox4x32 multipliers
+#define HGPU_PRNG_PHILOX_M1     0xCD9E8D57
+#define HGPU_PRNG_PHILOX_W0     0x9E3779B9                     // Weyl sequence key increments
+#define HGPU_PRNG_PHILOX_W1     0xBB67AE85
+#define HGPU_PRNG_PHILOX_rounds 10
+
+#define HGPU_PRNG_PHILOX_table_size 10                         // key (2 words), SEED4, finished work-items counter, offset (2 words), stride (2 words), first instance, consumed PRNs
+
+    typedef struct {
+        unsigned int key[2];        // key (randseries-dependent)
+        unsigned int counter[4];    // counter (block index low, stream index, block index high, SEED4)
+        unsigned int block[4];      // last produced block of 4 PRNs
+        unsigned int index;         // index of next unused PRN in block
+    } HGPU_PRNG_PHILOX_state_t;
+
+            static void   HGPU_PRNG_PHILOX_initialize(void* PRNG_state, unsigned int PRNG_randseries);
+            static void   HGPU_PRNG_PHILOX_block(const unsigned int* counter,const unsigned int* key,unsigned int* block);
+            static void   HGPU_PRNG_PHILOX_next_block(HGPU_PRNG_PHILOX_state_t* state);
+    static unsigned int   HGPU_PRNG_PHILOX_produce_one_uint_CPU(void* PRNG_state);
+          static double   HGPU_PRNG_PHILOX_produce_one_double_CPU(void* PRNG_state);
+            static void   HGPU_PRNG_PHILOX_skip_CPU(void* PRNG_state,u64_T n);
+            static void   HGPU_PRNG_PHILOX_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters);
+            static void   HGPU_PRNG_PHILOX_parameters_set(void* PRNG_state,HGPU_parameter** parameters);
+
+static void
+HGPU_PRNG_PHILOX_initialize(void* PRNG_state, unsigned int PRNG_randseries){
+    HGPU_PRNG_PHILOX_state_t* state = (HGPU_PRNG_PHILOX_state_t*) PRNG_state;
+    HGPU_PRNG_srand(PRNG_randseries);
+
+    state->key[0] = HGPU_PRNG_rand32bit();
+    state->key[1] = HGPU_PRNG_rand32bit();
+    for (int i=0; i<4; i++) {
+        state->counter[i] = 0;
+        state->block[i]   = 0;
+    }
+    state->index = 4;
+}
+
+// Philox4x32-10 bijection: block = philox(counter,key)
+static void
+HGPU_PRNG_PHILOX_block(const unsigned int* counter,const unsigned int* key,unsigned int* block){
+    u32_T ctr[4] = {counter[0], counter[1], counter[2], counter[3]};
+    u32_T k[2]   = {key[0], key[1]};
+    for (int i=0; i<HGPU_PRNG_PHILOX_rounds; i++) {
+        u64_T p0 = ((u64_T) HGPU_PRNG_PHILOX_M0) * ctr[0];
+        u64_T p1 = ((u64_T) HGPU_PRNG_PHILOX_M1) * ctr[2];
+        u32_T hi0 = (u32_T) (p0 >> 32);
+        u32_T hi1 = (u32_T) (p1 >> 32);
+        ctr[0] = hi1 ^ ctr[1] ^ k[0];
+        ctr[1] = (u32_T) p1;
+        ctr[2] = hi0 ^ ctr[3] ^ k[1];
+        ctr[3] = (u32_T) p0;
+        k[0] += HGPU_PRNG_PHILOX_W0;
+        k[1] += HGPU_PRNG_PHILOX_W1;
+    }
+    for (int i=0; i<4; i++) block[i] = ctr[i];
+}
+
+static void
+HGPU_PRNG_PHILOX_next_block(HGPU_PRNG_PHILOX_state_t* state){
+    HGPU_PRNG_PHILOX_block(state->counter,state->key,state->block);
+    if (!(++state->counter[0])) state->counter[2]++;
+    state->index = 0;
+}
+
+static unsigned int
+HGPU_PRNG_PHILOX_produce_one_uint_CPU(void* PRNG_state){
+    HGPU_PRNG_PHILOX_state_t* state = (HGPU_PRNG_PHILOX_state_t*) PRNG_state;
+    if (state->index > 3) HGPU_PRNG_PHILOX_next_block(state);
+    return state->block[state->index++];
+}
+
+static double
+HGPU_PRNG_PHILOX_produce_one_double_CPU(void* PRNG_state){
+    double y = (double) HGPU_PRNG_PHILOX_produce_one_uint_CPU(PRNG_state);
+    return (y / HGPU_PRNG_PHILOX_m);
+}
+
+// position of next PRN is (4*block index + index in block)
+static void
+HGPU_PRNG_PHILOX_skip_CPU(void* PRNG_state,u64_T n){
+    HGPU_PRNG_PHILOX_state_t* state = (HGPU_PRNG_PHILOX_state_t*) PRNG_state;
+    u64_T block = (((u64_T) state->counter[2]) << 32) | state->counter[0];
+    u64_T position = (state->index > 3) ? (block << 2) : (((block - 1) << 2) + state->index);
+
+    position += n;
+    block = position >> 2;
+    state->counter[0] = (unsigned int) block;
+    state->counter[2] = (unsigned int) (block >> 32);
+    state->index = 4;
+    if (position & 3) {
+        HGPU_PRNG_PHILOX_next_block(state);
+        state->index = (unsigned int) (position & 3);
+    }
+}
+
+static void
+HGPU_PRNG_PHILOX_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters){
+    HGPU_PRNG_PHILOX_state_t* state = (HGPU_PRNG_PHILOX_state_t*) PRNG_state;
+
+    // counter-based PRNG: no per-instance seeds, every instance is keyed by (key, global instance index) or is a substream of stream 0,
+    // skip-ahead, substreams and production calls only move one shared offset (plus stride between GIDs)
+    size_t counter_table_size      = HGPU_GPU_context_buffer_size_align(context,HGPU_PRNG_PHILOX_table_size);
+    cl_uint* PRNG_counter_table    = (cl_uint*) HGPU_GPU_context_buffer_host_alloc(context,counter_table_size,sizeof(cl_uint));
+    if ((!PRNG_counter_table))
+        HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for randoms");
+
+    // all instances start at CPU position, so first thread produces the same PRNs as CPU
+    u64_T block = (((u64_T) state->counter[2]) << 32) | state->counter[0];
+    u64_T position = (state->index > 3) ? (block << 2) : (((block - 1) << 2) + state->index);
+    memset(PRNG_counter_table,0,counter_table_size*sizeof(cl_uint));
+    PRNG_counter_table[0] = state->key[0];
+    PRNG_counter_table[1] = state->key[1];
+    PRNG_counter_table[2] = state->counter[3];
+    PRNG_counter_table[4] = (unsigned int) position;
+    PRNG_counter_table[5] = (unsigned int) (position >> 32);
+    PRNG_counter_table[8] = PRNG_parameters->instances_first;   // slice of instances uses the same counters as on single device
+
+    unsigned int counter_table_id = 0;
+    unsigned int randoms_id = 0;
+
+    counter_table_id = HGPU_GPU_context_buffer_init(context,PRNG_counter_table,HGPU_GPU_buffer_type_io,counter_table_size,sizeof(cl_uint));
+    HGPU_GPU_context_buffer_set_name(context,counter_table_id,(char*) "(PHILOX) PRNG_counter_table");
+
+    randoms_id = HGPU_PRNG_GPU_randoms_init(context,PRNG_parameters,"(PHILOX) PRNG_randoms");
+
+    PRNG_parameters->id_buffer_input_seeds = HGPU_GPU_MAX_BUFFERS;
+    PRNG_parameters->id_buffer_seeds       = counter_table_id;
+    PRNG_parameters->id_buffer_randoms     = randoms_id;
+}
+
+static void
+HGPU_PRNG_PHILOX_parameters_set(void* PRNG_state,HGPU_parameter** parameters){
+    if ((!parameters) || (!PRNG_state)) return;
+    HGPU_PRNG_PHILOX_state_t* state = (HGPU_PRNG_PHILOX_state_t*) PRNG_state;
+    HGPU_parameter* parameter = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_SEED1);
+    if (parameter) (*state).key[0] = parameter->value_integer;
+
+    parameter = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_SEED2);
+    if (parameter) (*state).key[1] = parameter->value_integer;
+
+    parameter = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_SEED3);
+    if (parameter) (*state).counter[2] = parameter->value_integer;
+
+    parameter = HGPU_parameters_get_by_name(parameters,(char*) HGPU_PARAMETER_PRNG_SEED4);
+    if (parameter) (*state).counter[3] = parameter->value_integer;
+}
+
+
+static const HGPU_PRNG_description
+HGPU_PRNG_PHILOX_description = {
+        "PHILOX",                                     // name
+        32,                                           // bitness
+        HGPU_PRNG_output_type_uint4by1,               // PRNG GPU output type
+        HGPU_PRNG_PHILOX_min,                         // PRNG_min_uint_value
+        HGPU_PRNG_PHILOX_max,                         // PRNG_max_uint_value
+        HGPU_PRNG_PHILOX_min_FP,                      // PRNG_min_double_value
+        HGPU_PRNG_PHILOX_max_FP,                      // PRNG_max_double_value
+        HGPU_PRNG_PHILOX_k,                           // PRNG_k_value
+        sizeof(HGPU_PRNG_PHILOX_state_t),             // size of PRNG state
+        &HGPU_PRNG_PHILOX_initialize,                 // PRNG initialization
+        &HGPU_PRNG_PHILOX_parameters_set,             // PRNG additional parameters initialization
+        &HGPU_PRNG_PHILOX_produce_one_uint_CPU,       // PRNG production one unsigned integer
+        &HGPU_PRNG_PHILOX_produce_one_double_CPU,     // PRNG production one double
+        &HGPU_PRNG_PHILOX_skip_CPU,                   // PRNG skip-ahead
+        //
+        &HGPU_PRNG_PHILOX_init_GPU,                   // PRNG init for GPU procedure
+        NULL,                                         // PRNG additional compilation options
+        HGPU_PRNG_CL_FILE,                            // PRNG source codes
+        NULL,                                         // PRNG init kernel
+        "philox",                                     // PRNG production kernel
+        "philox_skip"                                 // PRNG skip-ahead kernel
+};
+
+const HGPU_PRNG_description*  HGPU_PRNG_PHILOX  = &HGPU_PRNG_PHILOX_description;
+
+#undef HGPU_PRNG_CL_FILE
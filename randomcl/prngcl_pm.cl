@@ -46,6 +46,7 @@
 #define PRNGCL_PM_CL
 
 #include "prngcl_common.cl"
+#include "prngcl_skip.cl"
 
 #define PM_m_FP   (2147483647.0)
 #define PM_min    1
@@ -82,44 +83,81 @@ pm_step(uint4* seed)
     if (PM_test_1.w > PM_test_2.w) (*seed).w = PM_test_1.w - PM_test_2.w; else (*seed).w = PM_test_1.w - PM_test_2.w + (uint) PM_m;
 }
 
-__kernel void
-pm(__global uint4* seed_table, 
-   __global hgpu_float4* randoms,
-      const uint N)
+typedef struct _pm_state {
+    uint4 seed;
+} pm_state;
+
+__attribute__((always_inline)) pm_state
+pm_state_load(__global uint4* seed_table)
+{
+    pm_state state;
+    state.seed = seed_table[GID];
+    return state;
+}
+
+__attribute__((always_inline)) void
+pm_state_store(__global uint4* seed_table,pm_state* state)
+{
+    seed_table[GID] = (*state).seed;
+}
+
+__attribute__((always_inline)) uint4
+pm_next_uint4(pm_state* state)
+{
+    pm_step(&(*state).seed);
+    return (*state).seed;
+}
+
+__attribute__((always_inline)) hgpu_float4
+pm_next_float4(pm_state* state)
 {
-    uint giddst = GID;
-#ifdef PRECISION_DOUBLE  // if double precision is defined
-    uint4 rnd1, rnd2;
-    hgpu_double4 result;
-#else
-    float4 m = (float4) PM_m_FP;
-#endif
-    uint4 seed = seed_table[GID];
-    for (uint i = 0; i < N; i++) {
 #ifdef PRECISION_DOUBLE // if double precision is defined
+    uint4 rnd1, rnd2;
 #ifndef PRNG_SKIP_CHECK
-        rnd1 = (uint4) 0;
-        while ((rnd1.x <= PM_min) || (rnd1.x >= PM_max) ||
-               (rnd1.y <= PM_min) || (rnd1.y >= PM_max) ||
-               (rnd1.z <= PM_min) || (rnd1.z >= PM_max) ||
-               (rnd1.w <= PM_min) || (rnd1.w >= PM_max)
-              )
+    rnd1 = (uint4) 0;
+    while ((rnd1.x <= PM_min) || (rnd1.x >= PM_max) ||
+           (rnd1.y <= PM_min) || (rnd1.y >= PM_max) ||
+           (rnd1.z <= PM_min) || (rnd1.z >= PM_max) ||
+           (rnd1.w <= PM_min) || (rnd1.w >= PM_max)
+          )
 #endif
-        {
-            pm_step(&seed);
-            rnd1 = seed;
-        }
-        pm_step(&seed);
-        rnd2 = seed;
-
-        result = hgpu_uint4_to_double4(rnd1,rnd2,PM_min,PM_max,PM_k);
-        randoms[giddst] = result;
+    {
+        pm_step(&(*state).seed);
+        rnd1 = (*state).seed;
+    }
+    pm_step(&(*state).seed);
+    rnd2 = (*state).seed;
+
+    return hgpu_uint4_to_double4(rnd1,rnd2,PM_min,PM_max,PM_k);
 #else
-        pm_step(&seed);
-        randoms[giddst] = hgpu_uint4_to_float4(seed) / m;
+    return hgpu_uint4_to_float4(pm_next_uint4(state)) / ((float4) PM_m_FP);
 #endif
-        giddst += GID_SIZE;
-    }
+}
+
+#include "prngcl_distribution.cl"
+
+__kernel void
+pm(__global uint4* seed_table, 
+   __global prng_output_t* randoms,
+      const uint N)
+{
+    pm_state state = pm_state_load(seed_table);
+    prng_produce(randoms,&state,N);
+    pm_state_store(seed_table,&state);
+}
+
+__kernel void
+pm_skip(__global uint4* seed_table,
+          const ulong n,
+          const ulong stride)
+{
+    uint4 seed = seed_table[GID];
+    ulong stream = 4 * ((ulong) GID);   // every component of seed is a separate stream
+
+    seed.x = hgpu_skip_mulmod(seed.x, hgpu_skip_powmod(PM_a, n + stride * (stream    ), PM_m), PM_m);
+    seed.y = hgpu_skip_mulmod(seed.y, hgpu_skip_powmod(PM_a, n + stride * (stream + 1), PM_m), PM_m);
+    seed.z = hgpu_skip_mulmod(seed.z, hgpu_skip_powmod(PM_a, n + stride * (stream + 2), PM_m), PM_m);
+    seed.w = hgpu_skip_mulmod(seed.w, hgpu_skip_powmod(PM_a, n + stride * (stream + 3), PM_m), PM_m);
     seed_table[GID] = seed;
 }
 
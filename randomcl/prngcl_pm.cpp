@@ -69,6 +69,7 @@
             static void   HGPU_PRNG_PM_initialize(void* PRNG_state, unsigned int PRNG_randseries);
     static unsigned int   HGPU_PRNG_PM_produce_one_uint_CPU(void* PRNG_state);
           static double   HGPU_PRNG_PM_produce_one_double_CPU(void* PRNG_state);
+            static void   HGPU_PRNG_PM_skip_CPU(void* PRNG_state,u64_T n);
             static void   HGPU_PRNG_PM_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters);
             static void   HGPU_PRNG_PM_parameters_set(void* PRNG_state,HGPU_parameter** parameters);
 
@@ -104,20 +105,22 @@ HGPU_PRNG_PM_produce_one_double_CPU(void* PRNG_state){
 	return (y / HGPU_PRNG_PM_m);
 }
 
+static void
+HGPU_PRNG_PM_skip_CPU(void* PRNG_state,u64_T n){
+    HGPU_PRNG_PM_state_t* state = (HGPU_PRNG_PM_state_t*) PRNG_state;
+    u64_T a_n = HGPU_PRNG_skip_powmod(HGPU_PRNG_PM_a,n,HGPU_PRNG_PM_mi);
+
+    state->CPU_seed = (unsigned int) ((state->CPU_seed * a_n) % HGPU_PRNG_PM_mi);
+    state->seed     = state->CPU_seed;  // GPU starts from the new position
+}
+
 static void
 HGPU_PRNG_PM_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters){
     HGPU_PRNG_PM_state_t* state = (HGPU_PRNG_PM_state_t*) PRNG_state;
 
     size_t seed_table_size         = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances);
-    size_t randoms_size            = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * PRNG_parameters->samples);
-    cl_uint4* PRNG_seed_table_uint4= (cl_uint4*)  calloc(seed_table_size,sizeof(cl_uint4));
-    cl_float4*  PRNG_randoms        = NULL;
-    cl_double4* PRNG_randoms_double = NULL;
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        PRNG_randoms_double = (cl_double4*) calloc(randoms_size,sizeof(cl_double4));
-    else
-        PRNG_randoms        = (cl_float4*)  calloc(randoms_size,sizeof(cl_float4));
-    if ((!PRNG_seed_table_uint4) || ((!PRNG_randoms_double) && (!PRNG_randoms)))
+    cl_uint4* PRNG_seed_table_uint4= (cl_uint4*)  HGPU_GPU_context_buffer_host_alloc(context,seed_table_size,sizeof(cl_uint4));
+    if ((!PRNG_seed_table_uint4))
         HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for randoms");
 
     for (unsigned int i=0; i<seed_table_size; i++) {
@@ -129,17 +132,21 @@ HGPU_PRNG_PM_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_param
 
     PRNG_seed_table_uint4[0].s[0] = state->seed;    // setup first thread as CPU
 
+    if (PRNG_parameters->substream)     // substreams of CPU stream are set by skip-ahead kernel
+        for (unsigned int i=0; i<PRNG_parameters->instances; i++) {
+            PRNG_seed_table_uint4[i].s[0] = state->seed;
+            PRNG_seed_table_uint4[i].s[1] = state->seed;
+            PRNG_seed_table_uint4[i].s[2] = state->seed;
+            PRNG_seed_table_uint4[i].s[3] = state->seed;
+        }
+
     unsigned int seed_table_id = 0;
     unsigned int randoms_id = 0;
 
     seed_table_id = HGPU_GPU_context_buffer_init(context,PRNG_seed_table_uint4,HGPU_GPU_buffer_type_io,seed_table_size,sizeof(cl_uint4));
     HGPU_GPU_context_buffer_set_name(context,seed_table_id,(char*) "(PM) PRNG_seed_table");
 
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms_double,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_double4));
-    else
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_float4));
-    HGPU_GPU_context_buffer_set_name(context,randoms_id,(char*) "(PM) PRNG_randoms");
+    randoms_id = HGPU_PRNG_GPU_randoms_init(context,PRNG_parameters,"(PM) PRNG_randoms");
 
     PRNG_parameters->id_buffer_input_seeds = HGPU_GPU_MAX_BUFFERS;
     PRNG_parameters->id_buffer_seeds       = seed_table_id;
@@ -172,12 +179,14 @@ HGPU_PRNG_PM_description = {
         &HGPU_PRNG_PM_parameters_set,                 // PRNG additional parameters initialization
         &HGPU_PRNG_PM_produce_one_uint_CPU,           // PRNG production one unsigned integer
         &HGPU_PRNG_PM_produce_one_double_CPU,         // PRNG production one double
+        &HGPU_PRNG_PM_skip_CPU,                       // PRNG skip-ahead
         //
         &HGPU_PRNG_PM_init_GPU,                       // PRNG init for GPU procedure
         NULL,                                         // PRNG additional compilation options
         HGPU_PRNG_CL_FILE,                            // PRNG source codes
         NULL,                                         // PRNG init kernel
-        "pm"                                          // PRNG production kernel
+        "pm",                                         // PRNG production kernel
+        "pm_skip"                                     // PRNG skip-ahead kernel
 };
 
 const HGPU_PRNG_description*  HGPU_PRNG_PM  = &HGPU_PRNG_PM_description;
@@ -50,6 +50,7 @@
 #define PRNGCL_RANECU_CL
 
 #include "prngcl_common.cl"
+#include "prngcl_skip.cl"
 
 #define RANECU_m_FP   (2147483648.0f)
 #define RANECU_min    1
@@ -127,34 +128,76 @@ ranecu_step_double(uint4* seed1,uint4* seed2)
 #endif
 
 
+typedef struct _ranecu_state {
+    uint4 seed1;
+    uint4 seed2;
+} ranecu_state;
+
+__attribute__((always_inline)) ranecu_state
+ranecu_state_load(__global uint4* seed_table)
+{
+    ranecu_state state;
+    state.seed1 = seed_table[GID];
+    state.seed2 = seed_table[GID + GID_SIZE];
+    return state;
+}
+
+__attribute__((always_inline)) void
+ranecu_state_store(__global uint4* seed_table,ranecu_state* state)
+{
+    seed_table[GID] = (*state).seed1;
+    seed_table[GID + GID_SIZE] = (*state).seed2;
+}
+
+__attribute__((always_inline)) uint4
+ranecu_next_uint4(ranecu_state* state)
+{
+    uint4 result;
+    ranecu_step(&(*state).seed1,&(*state).seed2,&result);
+    return result;
+}
+
+__attribute__((always_inline)) hgpu_float4
+ranecu_next_float4(ranecu_state* state)
+{
+#ifdef PRECISION_DOUBLE // if double precision is defined
+    return ranecu_step_double(&(*state).seed1,&(*state).seed2);
+#else
+    return hgpu_uint4_to_float4(ranecu_next_uint4(state)) / ((float4) RANECU_twom31);
+#endif
+}
+
+#include "prngcl_distribution.cl"
+
 __kernel void
 ranecu(__global uint4* seed_table, 
-       __global hgpu_float4* randoms,
+       __global prng_output_t* randoms,
           const uint N)
 {
-    uint giddst = GID;
+    ranecu_state state = ranecu_state_load(seed_table);
+    prng_produce(randoms,&state,N);
+    ranecu_state_store(seed_table,&state);
+}
 
+__kernel void
+ranecu_skip(__global uint4* seed_table,
+              const ulong n,
+              const ulong stride)
+{
     uint4 seed1 = seed_table[GID];
     uint4 seed2 = seed_table[GID + GID_SIZE];
+    ulong stream = 4 * ((ulong) GID);   // every component of seeds is a separate stream
 
-#ifdef PRECISION_DOUBLE  // if double precision is defined
-    uint4 rnd1, rnd2;
-    hgpu_double4 result;
-#else
-    uint4 result;
-    float4 m = (float4) RANECU_twom31;
-#endif
+    seed1.x = hgpu_skip_mulmod(seed1.x, hgpu_skip_powmod(RANECU_seedP13, n + stride * (stream    ), RANECU_icons1), RANECU_icons1);
+    seed1.y = hgpu_skip_mulmod(seed1.y, hgpu_skip_powmod(RANECU_seedP13, n + stride * (stream + 1), RANECU_icons1), RANECU_icons1);
+    seed1.z = hgpu_skip_mulmod(seed1.z, hgpu_skip_powmod(RANECU_seedP13, n + stride * (stream + 2), RANECU_icons1), RANECU_icons1);
+    seed1.w = hgpu_skip_mulmod(seed1.w, hgpu_skip_powmod(RANECU_seedP13, n + stride * (stream + 3), RANECU_icons1), RANECU_icons1);
+
+    seed2.x = hgpu_skip_mulmod(seed2.x, hgpu_skip_powmod(RANECU_seedP23, n + stride * (stream    ), RANECU_icons2), RANECU_icons2);
+    seed2.y = hgpu_skip_mulmod(seed2.y, hgpu_skip_powmod(RANECU_seedP23, n + stride * (stream + 1), RANECU_icons2), RANECU_icons2);
+    seed2.z = hgpu_skip_mulmod(seed2.z, hgpu_skip_powmod(RANECU_seedP23, n + stride * (stream + 2), RANECU_icons2), RANECU_icons2);
+    seed2.w = hgpu_skip_mulmod(seed2.w, hgpu_skip_powmod(RANECU_seedP23, n + stride * (stream + 3), RANECU_icons2), RANECU_icons2);
 
-    for (uint i = 0; i < N; i++) {
-#ifdef PRECISION_DOUBLE // if double precision is defined
-        result = ranecu_step_double(&seed1,&seed2);
-        randoms[giddst] = result;
-#else
-        ranecu_step(&seed1,&seed2,&result);
-        randoms[giddst] = hgpu_uint4_to_float4(result) / m;
-#endif
-        giddst += GID_SIZE;
-    }
     seed_table[GID] = seed1;
     seed_table[GID + GID_SIZE] = seed2;
 }
@@ -83,6 +83,7 @@
             static void   HGPU_PRNG_RANECU_initialize(void* PRNG_state, unsigned int PRNG_randseries);
     static unsigned int   HGPU_PRNG_RANECU_produce_one_uint_CPU(void* PRNG_state);
           static double   HGPU_PRNG_RANECU_produce_one_double_CPU(void* PRNG_state);
+            static void   HGPU_PRNG_RANECU_skip_CPU(void* PRNG_state,u64_T n);
             static void   HGPU_PRNG_RANECU_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters);
             static void   HGPU_PRNG_RANECU_parameters_set(void* PRNG_state,HGPU_parameter** parameters);
 
@@ -120,20 +121,23 @@ HGPU_PRNG_RANECU_produce_one_double_CPU(void* PRNG_state){
     return (y / HGPU_PRNG_RANECU_twom31);
 }
 
+static void
+HGPU_PRNG_RANECU_skip_CPU(void* PRNG_state,u64_T n){
+    HGPU_PRNG_RANECU_state_t* state = (HGPU_PRNG_RANECU_state_t*) PRNG_state;
+    u64_T a1_n = HGPU_PRNG_skip_powmod(HGPU_PRNG_RANECU_seedP13,n,HGPU_PRNG_RANECU_icons1);
+    u64_T a2_n = HGPU_PRNG_skip_powmod(HGPU_PRNG_RANECU_seedP23,n,HGPU_PRNG_RANECU_icons2);
+
+    state->jseed1 = (int) ((((u64_T) state->jseed1) * a1_n) % HGPU_PRNG_RANECU_icons1);
+    state->jseed2 = (int) ((((u64_T) state->jseed2) * a2_n) % HGPU_PRNG_RANECU_icons2);
+}
+
 static void
 HGPU_PRNG_RANECU_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters){
     HGPU_PRNG_RANECU_state_t* state = (HGPU_PRNG_RANECU_state_t*) PRNG_state;
 
     size_t seed_table_size         = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * 2);
-    size_t randoms_size            = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * PRNG_parameters->samples);
-    cl_uint4* PRNG_seed_table_uint4= (cl_uint4*)  calloc(seed_table_size,sizeof(cl_uint4));
-    cl_float4*  PRNG_randoms        = NULL;
-    cl_double4* PRNG_randoms_double = NULL;
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        PRNG_randoms_double = (cl_double4*) calloc(randoms_size,sizeof(cl_double4));
-    else
-        PRNG_randoms        = (cl_float4*)  calloc(randoms_size,sizeof(cl_float4));
-    if ((!PRNG_seed_table_uint4) || ((!PRNG_randoms_double) && (!PRNG_randoms)))
+    cl_uint4* PRNG_seed_table_uint4= (cl_uint4*)  HGPU_GPU_context_buffer_host_alloc(context,seed_table_size,sizeof(cl_uint4));
+    if ((!PRNG_seed_table_uint4))
         HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for randoms");
 
     for (size_t i=0; i<(seed_table_size>>1); i++) {
@@ -153,17 +157,20 @@ HGPU_PRNG_RANECU_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_p
     PRNG_seed_table_uint4[0].s[0] = state->jseed1;    // setup first thread as CPU
     PRNG_seed_table_uint4[PRNG_parameters->instances].s[0] = state->jseed2;
 
+    if (PRNG_parameters->substream)     // substreams of CPU stream are set by skip-ahead kernel
+        for (unsigned int i=0; i<PRNG_parameters->instances; i++)
+            for (int j=0; j<4; j++) {
+                PRNG_seed_table_uint4[i].s[j] = state->jseed1;
+                PRNG_seed_table_uint4[PRNG_parameters->instances + i].s[j] = state->jseed2;
+            }
+
     unsigned int seed_table_id = 0;
     unsigned int randoms_id = 0;
 
     seed_table_id = HGPU_GPU_context_buffer_init(context,PRNG_seed_table_uint4,HGPU_GPU_buffer_type_io,seed_table_size,sizeof(cl_uint4));
     HGPU_GPU_context_buffer_set_name(context,seed_table_id,(char*) "(RANECU) PRNG_seed_table");
 
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms_double,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_double4));
-    else
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_float4));
-    HGPU_GPU_context_buffer_set_name(context,randoms_id,(char*) "(RANECU) PRNG_randoms");
+    randoms_id = HGPU_PRNG_GPU_randoms_init(context,PRNG_parameters,"(RANECU) PRNG_randoms");
 
     PRNG_parameters->id_buffer_input_seeds = HGPU_GPU_MAX_BUFFERS;
     PRNG_parameters->id_buffer_seeds       = seed_table_id;
@@ -197,12 +204,14 @@ HGPU_PRNG_RANECU_description = {
         &HGPU_PRNG_RANECU_parameters_set,             // PRNG additional parameters initialization
         &HGPU_PRNG_RANECU_produce_one_uint_CPU,       // PRNG production one unsigned integer
         &HGPU_PRNG_RANECU_produce_one_double_CPU,     // PRNG production one double
+        &HGPU_PRNG_RANECU_skip_CPU,                   // PRNG skip-ahead
         //
         &HGPU_PRNG_RANECU_init_GPU,                   // PRNG init for GPU procedure
         NULL,                                         // PRNG additional compilation options
         HGPU_PRNG_CL_FILE,                            // PRNG source codes
         NULL,                                         // PRNG init kernel
-        "ranecu"                                      // PRNG production kernel
+        "ranecu",                                     // PRNG production kernel
+        "ranecu_skip"                                 // PRNG skip-ahead kernel
 };
 
 const HGPU_PRNG_description*  HGPU_PRNG_RANECU = &HGPU_PRNG_RANECU_description;
@@ -528,36 +528,60 @@ rl_step_double(float4* RL_seed0,float4* RL_seed1,float4* RL_seed2,float4* RL_see
 #endif
 
 
-__kernel void
-ranlux(__global float4 * seedtable,__global hgpu_float4 * prns, const uint samples)
+typedef struct _ranlux_state {
+    float4 seed0;
+    float4 seed1;
+    float4 seed2;
+    float4 seed3;
+    float4 seed4;
+    float4 seed5;
+    float4 carin;       // RL_i24, RL_j24, RL_in24, RL_carry
+} ranlux_state;
+
+__attribute__((always_inline)) ranlux_state
+ranlux_state_load(__global float4 * seedtable)
+{
+    ranlux_state state;
+		state.seed0 = seedtable[GID + 0 * GID_SIZE];
+		state.seed1 = seedtable[GID + 1 * GID_SIZE];
+		state.seed2 = seedtable[GID + 2 * GID_SIZE];
+		state.seed3 = seedtable[GID + 3 * GID_SIZE];
+		state.seed4 = seedtable[GID + 4 * GID_SIZE];
+		state.seed5 = seedtable[GID + 5 * GID_SIZE];
+		state.carin = seedtable[GID + 6 * GID_SIZE];
+    return state;
+}
+
+__attribute__((always_inline)) void
+ranlux_state_store(__global float4 * seedtable,ranlux_state* state)
+{
+	seedtable[GID + 0 * GID_SIZE] = (*state).seed0;
+	seedtable[GID + 1 * GID_SIZE] = (*state).seed1;
+	seedtable[GID + 2 * GID_SIZE] = (*state).seed2;
+	seedtable[GID + 3 * GID_SIZE] = (*state).seed3;
+	seedtable[GID + 4 * GID_SIZE] = (*state).seed4;
+	seedtable[GID + 5 * GID_SIZE] = (*state).seed5;
+	seedtable[GID + 6 * GID_SIZE] = (*state).carin;
+}
+
+__attribute__((always_inline)) hgpu_float4
+ranlux_next_float4(ranlux_state* state)
 {
-    uint giddst = GID;
-		float4 RL_seed0 = seedtable[GID + 0 * GID_SIZE];
-		float4 RL_seed1 = seedtable[GID + 1 * GID_SIZE];
-		float4 RL_seed2 = seedtable[GID + 2 * GID_SIZE];
-		float4 RL_seed3 = seedtable[GID + 3 * GID_SIZE];
-		float4 RL_seed4 = seedtable[GID + 4 * GID_SIZE];
-		float4 RL_seed5 = seedtable[GID + 5 * GID_SIZE];
-		float4 RL_carin = seedtable[GID + 6 * GID_SIZE];    // RL_i24, RL_j24, RL_in24, RL_carry
-
-	for (int i=0; i<samples; i++) {
 #ifdef PRECISION_DOUBLE // if double precision is defined
-        hgpu_double4 result = rl_step_double(&RL_seed0,&RL_seed1,&RL_seed2,&RL_seed3,&RL_seed4,&RL_seed5,&RL_carin);
-        prns[giddst] = result;
+    return rl_step_double(&(*state).seed0,&(*state).seed1,&(*state).seed2,&(*state).seed3,&(*state).seed4,&(*state).seed5,&(*state).carin);
 #else
-        float4 uni = rl_step(&RL_seed0,&RL_seed1,&RL_seed2,&RL_seed3,&RL_seed4,&RL_seed5,&RL_carin);
-		prns[giddst] = uni;
+    return rl_step(&(*state).seed0,&(*state).seed1,&(*state).seed2,&(*state).seed3,&(*state).seed4,&(*state).seed5,&(*state).carin);
 #endif
-		giddst += GID_SIZE;
-	}
-
-	seedtable[GID + 0 * GID_SIZE] = RL_seed0;
-	seedtable[GID + 1 * GID_SIZE] = RL_seed1;
-	seedtable[GID + 2 * GID_SIZE] = RL_seed2;
-	seedtable[GID + 3 * GID_SIZE] = RL_seed3;
-	seedtable[GID + 4 * GID_SIZE] = RL_seed4;
-	seedtable[GID + 5 * GID_SIZE] = RL_seed5;
-	seedtable[GID + 6 * GID_SIZE] = RL_carin;
+}
+
+#include "prngcl_distribution.cl"
+
+__kernel void
+ranlux(__global float4 * seedtable,__global prng_output_t * prns, const uint samples)
+{
+    ranlux_state state = ranlux_state_load(seedtable);
+    prng_produce(prns,&state,samples);
+    ranlux_state_store(seedtable,&state);
 }
 
 
@@ -165,16 +165,9 @@ HGPU_PRNG_RANLUX_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_p
 
     size_t seeds_size      = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances);
     size_t seed_table_size = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * 7); // 7 = size of Ranlux seed table for each PRNG (in quads)
-    size_t randoms_size    = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * PRNG_parameters->samples);
-    cl_uint*    PRNG_seeds             = (cl_uint*)   calloc(seeds_size,sizeof(cl_uint));
-    cl_float4*  PRNG_seed_table_float4 = (cl_float4*) calloc(seed_table_size,sizeof(cl_float4));
-    cl_float4*  PRNG_randoms        = NULL;
-    cl_double4* PRNG_randoms_double = NULL;
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        PRNG_randoms_double = (cl_double4*) calloc(randoms_size,sizeof(cl_double4));
-    else
-        PRNG_randoms        = (cl_float4*)  calloc(randoms_size,sizeof(cl_float4));
-    if ((!PRNG_seeds) || (!PRNG_seed_table_float4) || ((!PRNG_randoms_double) && (!PRNG_randoms)))
+    cl_uint*    PRNG_seeds             = (cl_uint*)   HGPU_GPU_context_buffer_host_alloc(context,seeds_size,sizeof(cl_uint));
+    cl_float4*  PRNG_seed_table_float4 = (cl_float4*) HGPU_GPU_context_buffer_host_alloc(context,seed_table_size,sizeof(cl_float4));
+    if ((!PRNG_seeds) || (!PRNG_seed_table_float4))
         HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for randoms");
 
     for (unsigned int i=1; i<seeds_size; i++)
@@ -192,11 +185,7 @@ HGPU_PRNG_RANLUX_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_p
     seed_table_id = HGPU_GPU_context_buffer_init(context,PRNG_seed_table_float4,HGPU_GPU_buffer_type_io,seed_table_size,sizeof(cl_float4));
     HGPU_GPU_context_buffer_set_name(context,seed_table_id,(char*) "(RANLUX) PRNG_seed_table");
 
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms_double,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_double4));
-    else
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_float4));
-    HGPU_GPU_context_buffer_set_name(context,randoms_id,(char*) "(RANLUX) PRNG_randoms");
+    randoms_id = HGPU_PRNG_GPU_randoms_init(context,PRNG_parameters,"(RANLUX) PRNG_randoms");
 
     PRNG_parameters->id_buffer_input_seeds = seeds_id;
     PRNG_parameters->id_buffer_seeds       = seed_table_id;
@@ -243,12 +232,14 @@ HGPU_PRNG_RANLUX_description = {
         &HGPU_PRNG_RANLUX_parameters_set,             // PRNG additional parameters initialization
         NULL,                                         // PRNG production one unsigned integer
         &HGPU_PRNG_RANLUX_produce_one_double_CPU,     // PRNG production one double
+        NULL,                                         // PRNG skip-ahead
         //
         &HGPU_PRNG_RANLUX_init_GPU,                   // PRNG init for GPU procedure
         &HGPU_PRNG_RANLUX_options_GPU,                // PRNG additional compilation options
         HGPU_PRNG_CL_FILE,                            // PRNG source codes
         "ranlux_init",                                // PRNG init kernel
-        "ranlux"                                      // PRNG production kernel
+        "ranlux",                                     // PRNG production kernel
+        NULL                                          // PRNG skip-ahead kernel
 };
 
 const HGPU_PRNG_description*  HGPU_PRNG_RANLUX = &HGPU_PRNG_RANLUX_description;
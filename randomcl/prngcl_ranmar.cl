@@ -109,13 +109,35 @@ ranmar_init(const __global uint4* seeds, __global float4* seedtable)
     seedtable[GID + GID_SIZE * 97] = indx;   // (RM_I97,RM_J97,RM_C,0)
 }
 
+// lag table placement for production kernel:
+//   RANMAR_PRIVATE    - in private memory of work-item (CPU devices)
+//   RANMAR_LOCAL_SIZE - in local memory, RANMAR_LOCAL_SIZE work-items per work-group (GPU devices)
+//   otherwise         - in global memory (seed table)
+#if defined(RANMAR_PRIVATE)
+#define RM_SPACE
+#define RM_INDEX(n) (n)
+#elif defined(RANMAR_LOCAL_SIZE)
+#define RM_SPACE    __local
+#define RM_INDEX(n) (get_local_id(0) + RANMAR_LOCAL_SIZE * (n))
+#else
+#define RM_SPACE    __global
+#define RM_INDEX(n) (GID + GID_SIZE * (n))
+#endif
+
+typedef struct _ranmar_state {
+    RM_SPACE float4* lagtable;  // lag table of work-item
+    uint  I97;
+    uint  J97;
+    float uniz;
+} ranmar_state;
+
 __attribute__((always_inline)) float4
-rm_step(__global float4 * seedtable,uint* RM_I97,uint* RM_J97,float* uniz)
+rm_step(RM_SPACE float4 * lagtable,uint* RM_I97,uint* RM_J97,float* uniz)
 {
         float4 uni;
-        uni = seedtable[GID + GID_SIZE * (*RM_I97)] - seedtable[GID + GID_SIZE * (*RM_J97)];
+        uni = lagtable[RM_INDEX(*RM_I97)] - lagtable[RM_INDEX(*RM_J97)];
 	    uni = select(uni, (uni + 1.0f), uni < (float4) 0.0f);
-        seedtable[GID + GID_SIZE * (*RM_I97)] = uni;
+        lagtable[RM_INDEX(*RM_I97)] = uni;
 
 	    if ((*RM_I97) == 0) (*RM_I97) = 97;
 	    if ((*RM_J97) == 0) (*RM_J97) = 97;
@@ -131,7 +153,7 @@ rm_step(__global float4 * seedtable,uint* RM_I97,uint* RM_J97,float* uniz)
 
 #ifdef PRECISION_DOUBLE  // if double precision is defined
 __attribute__((always_inline)) hgpu_double4
-rm_step_double(__global float4 * seedtable,uint* RM_I97,uint* RM_J97,float* uniz)
+rm_step_double(RM_SPACE float4 * lagtable,uint* RM_I97,uint* RM_J97,float* uniz)
 {
     hgpu_double4 result;
     float4 rnd1 = 0.0;
@@ -143,44 +165,98 @@ rm_step_double(__global float4 * seedtable,uint* RM_I97,uint* RM_J97,float* uniz
            (rnd1.w <= RM_min) || (rnd1.w >= RM_max)
           )
 #endif
-        rnd1 = rm_step(seedtable,RM_I97,RM_J97,uniz);
-    rnd2 = rm_step(seedtable,RM_I97,RM_J97,uniz);
+        rnd1 = rm_step(lagtable,RM_I97,RM_J97,uniz);
+    rnd2 = rm_step(lagtable,RM_I97,RM_J97,uniz);
 
     result = hgpu_float4_to_double4(rnd1,rnd2,RM_min,RM_max,RM_k);
     return result;
 }
 #endif
 
-__kernel void
-ranmar(__global float4 * seedtable,__global hgpu_float4 * prns, const uint samples)
+__attribute__((always_inline)) void
+ranmar_state_load_indices(__global float4 * seedtable,ranmar_state* state)
 {
-    uint giddst = GID;
-    float4 uni = (float4) 0.0;
     Uint_and_Float indx_I97, indx_J97;
     float4 indx = seedtable[GID + GID_SIZE * 97];
     indx_I97.float_value = indx.x;
     indx_J97.float_value = indx.y;
-    uint RM_I97 = indx_I97.uint_value;
-    uint RM_J97 = indx_J97.uint_value;
-    float uniz = indx.z;
-    for (uint i=0; i<samples; i++) {
-#ifdef PRECISION_DOUBLE // if double precision is defined
-        hgpu_double4 result = rm_step_double(seedtable,&RM_I97,&RM_J97,&uniz);
-        prns[giddst] = result;
-#else
-        uni = rm_step(seedtable,&RM_I97,&RM_J97,&uniz);
-        prns[giddst] = uni;
-#endif
-        giddst += GID_SIZE;
-    }
+    (*state).I97  = indx_I97.uint_value;
+    (*state).J97  = indx_J97.uint_value;
+    (*state).uniz = indx.z;
+}
 
-    indx_I97.uint_value = RM_I97;
-    indx_J97.uint_value = RM_J97;
-    indx.z = uniz;
+__attribute__((always_inline)) void
+ranmar_state_store_indices(__global float4 * seedtable,ranmar_state* state)
+{
+    Uint_and_Float indx_I97, indx_J97;
+    float4 indx;
+    indx_I97.uint_value = (*state).I97;
+    indx_J97.uint_value = (*state).J97;
     indx.x = indx_I97.float_value;
     indx.y = indx_J97.float_value;
+    indx.z = (*state).uniz;
+    indx.w = 0.0f;
     seedtable[GID + GID_SIZE * 97] = indx;
 }
 
+#if !defined(RANMAR_PRIVATE) && !defined(RANMAR_LOCAL_SIZE)
+// lag table stays in global memory
+__attribute__((always_inline)) ranmar_state
+ranmar_state_load(__global float4 * seedtable)
+{
+    ranmar_state state;
+    state.lagtable = seedtable;
+    ranmar_state_load_indices(seedtable,&state);
+    return state;
+}
+
+__attribute__((always_inline)) void
+ranmar_state_store(__global float4 * seedtable,ranmar_state* state)
+{
+    ranmar_state_store_indices(seedtable,state);
+}
+#endif
+
+__attribute__((always_inline)) hgpu_float4
+ranmar_next_float4(ranmar_state* state)
+{
+#ifdef PRECISION_DOUBLE // if double precision is defined
+    return rm_step_double((*state).lagtable,&(*state).I97,&(*state).J97,&(*state).uniz);
+#else
+    return rm_step((*state).lagtable,&(*state).I97,&(*state).J97,&(*state).uniz);
+#endif
+}
+
+#include "prngcl_distribution.cl"
+
+__kernel
+#if defined(RANMAR_LOCAL_SIZE) && !defined(RANMAR_PRIVATE)
+__attribute__((reqd_work_group_size(RANMAR_LOCAL_SIZE, 1, 1)))
+#endif
+void
+ranmar(__global float4 * seedtable,__global prng_output_t * prns, const uint samples)
+{
+    ranmar_state state;
+#if defined(RANMAR_PRIVATE)
+    float4 lagtable[97];
+#elif defined(RANMAR_LOCAL_SIZE)
+    __local float4 lagtable[97 * RANMAR_LOCAL_SIZE];
+#else
+    __global float4 * lagtable = seedtable;
+#endif
+#if defined(RANMAR_PRIVATE) || defined(RANMAR_LOCAL_SIZE)
+    // every work-item stages its own lag table, so no barriers are needed
+    for (uint n = 0; n < 97; n++)
+        lagtable[RM_INDEX(n)] = seedtable[GID + GID_SIZE * n];
+#endif
+    state.lagtable = lagtable;
+    ranmar_state_load_indices(seedtable,&state);
+    prng_produce(prns,&state,samples);
+#if defined(RANMAR_PRIVATE) || defined(RANMAR_LOCAL_SIZE)
+    for (uint n = 0; n < 97; n++)
+        seedtable[GID + GID_SIZE * n] = lagtable[RM_INDEX(n)];
+#endif
+    ranmar_state_store_indices(seedtable,&state);
+}
 
 #endif
@@ -64,6 +64,8 @@
 #define HGPU_PRNG_RANMAR_init_1 31328
 #define HGPU_PRNG_RANMAR_init_2 30081
 
+#define HGPU_PRNG_RANMAR_min_local_size 8                      // minimal work-group size for lag table in local memory
+
 
     typedef struct {
                float  seeds[97];
@@ -79,6 +81,7 @@
                    void   HGPU_PRNG_RANMAR_initialize_seedtable_CPU(void* PRNG_state);
           static double   HGPU_PRNG_RANMAR_produce_one_double_CPU(void* PRNG_state);
             static void   HGPU_PRNG_RANMAR_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters);
+            static char*  HGPU_PRNG_RANMAR_options_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters);
             static void   HGPU_PRNG_RANMAR_parameters_set(void* PRNG_state,HGPU_parameter** parameters);
 
 static void
@@ -147,16 +150,9 @@ HGPU_PRNG_RANMAR_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_p
 
     size_t seeds_size              = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * 2);
     size_t seed_table_size         = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * 2 * (97+1)); // 97 - size of seed table, 1 - size of indices
-    size_t randoms_size            = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * PRNG_parameters->samples);
-    cl_uint4*  PRNG_seeds           = (cl_uint4*)  calloc(seeds_size,sizeof(cl_uint4));
-    cl_float4* PRNG_seed_table_float4= (cl_float4*) calloc(seed_table_size,sizeof(cl_float4));
-    cl_float4*  PRNG_randoms        = NULL;
-    cl_double4* PRNG_randoms_double = NULL;
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        PRNG_randoms_double = (cl_double4*) calloc(randoms_size,sizeof(cl_double4));
-    else
-        PRNG_randoms        = (cl_float4*)  calloc(randoms_size,sizeof(cl_float4));
-    if ((!PRNG_seeds) || (!PRNG_seed_table_float4) || ((!PRNG_randoms_double) && (!PRNG_randoms)))
+    cl_uint4*  PRNG_seeds           = (cl_uint4*)  HGPU_GPU_context_buffer_host_alloc(context,seeds_size,sizeof(cl_uint4));
+    cl_float4* PRNG_seed_table_float4= (cl_float4*) HGPU_GPU_context_buffer_host_alloc(context,seed_table_size,sizeof(cl_float4));
+    if ((!PRNG_seeds) || (!PRNG_seed_table_float4))
         HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for randoms");
 
     for (size_t i=0; i<(seeds_size>>1); i++) {
@@ -186,17 +182,44 @@ HGPU_PRNG_RANMAR_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_p
     seed_table_id = HGPU_GPU_context_buffer_init(context,PRNG_seed_table_float4,HGPU_GPU_buffer_type_io,seed_table_size,sizeof(cl_float4));
     HGPU_GPU_context_buffer_set_name(context,seed_table_id,(char*) "(RANMAR) PRNG_seed_table");
 
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms_double,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_double4));
-    else
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_float4));
-    HGPU_GPU_context_buffer_set_name(context,randoms_id,(char*) "(RANMAR) PRNG_randoms");
+    randoms_id = HGPU_PRNG_GPU_randoms_init(context,PRNG_parameters,"(RANMAR) PRNG_randoms");
 
     PRNG_parameters->id_buffer_input_seeds = seeds_id;
     PRNG_parameters->id_buffer_seeds       = seed_table_id;
     PRNG_parameters->id_buffer_randoms     = randoms_id;
 }
 
+// place lag table of production kernel: private memory on CPU, local memory on GPU (if it fits), global memory otherwise
+static char*
+HGPU_PRNG_RANMAR_options_GPU(HGPU_GPU_context* context,void*,HGPU_PRNG_parameters* PRNG_parameters){
+    char* result = NULL;
+    if ((!context) || (!PRNG_parameters)) return result;
+    result = (char*) calloc(HGPU_GPU_MAX_OPTIONS_LENGTH,sizeof(char));
+    PRNG_parameters->local_size = 0;
+    if (PRNG_parameters->device_api) return result;     // lag table in global memory for device-side API
+
+    cl_device_type device_type = (cl_device_type) HGPU_GPU_device_get_info_uint(context->device,CL_DEVICE_TYPE);
+    if (device_type & CL_DEVICE_TYPE_CPU) {
+        sprintf_s(result,HGPU_GPU_MAX_OPTIONS_LENGTH,"-D RANMAR_PRIVATE");
+        return result;
+    }
+
+    // work-group size: 97 float4 per work-item in local memory, power of 2, divides number of instances
+    size_t local_size = (size_t) (context->device_info.local_memory_size / (97 * sizeof(cl_float4)));
+    if (local_size > context->device_info.max_workgroup_size) local_size = context->device_info.max_workgroup_size;
+    if ((context->debug_flags.max_workgroup_size) && (local_size > context->debug_flags.max_workgroup_size))
+        local_size = context->debug_flags.max_workgroup_size;
+    size_t local_size_pow2 = 1;
+    while (((local_size_pow2 << 1) <= local_size) && (!(PRNG_parameters->instances % (local_size_pow2 << 1))))
+        local_size_pow2 <<= 1;
+
+    if (local_size_pow2 >= HGPU_PRNG_RANMAR_min_local_size) {
+        PRNG_parameters->local_size = (unsigned int) local_size_pow2;
+        sprintf_s(result,HGPU_GPU_MAX_OPTIONS_LENGTH,"-D RANMAR_LOCAL_SIZE=%u",PRNG_parameters->local_size);
+    }
+    return result;
+}
+
 static void
 HGPU_PRNG_RANMAR_parameters_set(void* PRNG_state,HGPU_parameter** parameters){
     if ((!parameters) || (!PRNG_state)) return;
@@ -224,12 +247,14 @@ HGPU_PRNG_RANMAR_description = {
         &HGPU_PRNG_RANMAR_parameters_set,             // PRNG additional parameters initialization
         NULL,                                         // PRNG production one unsigned integer
         &HGPU_PRNG_RANMAR_produce_one_double_CPU,     // PRNG production one double
+        NULL,                                         // PRNG skip-ahead
         //
         &HGPU_PRNG_RANMAR_init_GPU,                   // PRNG init for GPU procedure
-        NULL,                                         // PRNG additional compilation options
+        &HGPU_PRNG_RANMAR_options_GPU,                // PRNG additional compilation options
         HGPU_PRNG_CL_FILE,                            // PRNG source codes
         "ranmar_init",                                // PRNG init kernel
-        "ranmar"                                      // PRNG production kernel
+        "ranmar",                                     // PRNG production kernel
+        NULL                                          // PRNG skip-ahead kernel
 };
 
 const HGPU_PRNG_description*  HGPU_PRNG_RANMAR = &HGPU_PRNG_RANMAR_description;
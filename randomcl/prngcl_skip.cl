@@ -0,0 +1,129 @@
+/******************************************************************************
+ * @file     prngcl_skip.cl
+ * @author   Vadim Demchik <vadimdi@yahoo.com>
+ * @version  1.1.2
+ *
+ * @brief    [PRNGCL library]
+ *           common module for skip-ahead of PRNG implementations
+ *           contains modular and GF(2) polynomial exponentiation
+ *
+ *
+ * @section  LICENSE
+ *
+ * Copyright (c) 2013-2015 Vadim Demchik
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *    Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *****************************************************************************/
+
+#ifndef PRNGCL_SKIP_CL
+#define PRNGCL_SKIP_CL
+
+#define HGPU_SKIP_GF2_MAX_WORDS   8       // maximal degree of characteristic polynomial is 256
+
+// a*b mod m
+inline uint hgpu_skip_mulmod(uint a, uint b, uint m){
+    return (uint) ((((ulong) a) * b) % m);
+}
+
+// a^n mod m (skip-ahead for multiplicative congruential PRNGs)
+inline uint hgpu_skip_powmod(uint a, ulong n, uint m){
+    ulong result = 1 % m;
+    ulong base   = a % m;
+    while (n) {
+        if (n & 1) result = (result * base) % m;
+        base = (base * base) % m;
+        n >>= 1;
+    }
+    return (uint) result;
+}
+
+// c = a*b mod m for 3x3 matrices (c may coincide with a or b)
+inline void hgpu_skip_matrix_mulmod(uint* a, uint* b, uint m, uint* c){
+    uint r[9];
+    for (uint i = 0; i < 3; i++)
+        for (uint j = 0; j < 3; j++) {
+            ulong s = 0;
+            for (uint k = 0; k < 3; k++) s = (s + (((ulong) a[3*i+k]) * b[3*k+j]) % m) % m;
+            r[3*i+j] = (uint) s;
+        }
+    for (uint i = 0; i < 9; i++) c[i] = r[i];
+}
+
+// (A^n mod m)*v for 3x3 matrix A (skip-ahead for multiple recursive PRNGs)
+inline uint4 hgpu_skip_matrix_powmod(__constant uint* matrix, ulong n, uint m, uint4 v){
+    uint base[9];
+    uint result[9];
+    for (uint i = 0; i < 9; i++) {
+        base[i]   = matrix[i];
+        result[i] = ((i % 4) == 0) ? 1 : 0;
+    }
+    while (n) {
+        if (n & 1) hgpu_skip_matrix_mulmod(result, base, m, result);
+        hgpu_skip_matrix_mulmod(base, base, m, base);
+        n >>= 1;
+    }
+    uint4 r = v;
+    r.x = (uint) (((((ulong) result[0]) * v.x) % m + (((ulong) result[1]) * v.y) % m + (((ulong) result[2]) * v.z) % m) % m);
+    r.y = (uint) (((((ulong) result[3]) * v.x) % m + (((ulong) result[4]) * v.y) % m + (((ulong) result[5]) * v.z) % m) % m);
+    r.z = (uint) (((((ulong) result[6]) * v.x) % m + (((ulong) result[7]) * v.y) % m + (((ulong) result[8]) * v.z) % m) % m);
+    return r;
+}
+
+// x^n mod P(x) over GF(2) (skip-ahead for F2-linear PRNGs)
+// P(x) has degree 32*words, its leading coefficient is implicit
+inline void hgpu_skip_gf2_powmod(__constant uint* polynomial, uint words, ulong n, uint* result){
+    uint square[2*HGPU_SKIP_GF2_MAX_WORDS];
+    uint degree = 32 * words;
+    for (uint i = 0; i < words; i++) result[i] = 0;
+    result[0] = 1;
+
+    int bit = 63;
+    while ((bit >= 0) && (!((n >> bit) & 1))) bit--;
+    for (; bit >= 0; bit--) {
+        // result = result^2 mod P
+        for (uint i = 0; i < 2*words; i++) square[i] = 0;
+        for (uint i = 0; i < degree; i++)
+            if ((result[i>>5] >> (i&31)) & 1) square[(2*i)>>5] |= 1u << ((2*i)&31);
+        for (uint i = 2*degree-1; i >= degree; i--) {
+            if (!((square[i>>5] >> (i&31)) & 1)) continue;
+            square[i>>5] ^= 1u << (i&31);
+            uint shift = i - degree;
+            for (uint k = 0; k < words; k++) {
+                square[k + (shift>>5)] ^= polynomial[k] << (shift&31);
+                if (shift&31) square[k + (shift>>5) + 1] ^= polynomial[k] >> (32 - (shift&31));
+            }
+        }
+        for (uint i = 0; i < words; i++) result[i] = square[i];
+
+        // result = result*x mod P
+        if ((n >> bit) & 1) {
+            uint carry = result[words-1] >> 31;
+            for (uint i = words-1; i > 0; i--) result[i] = (result[i] << 1) | (result[i-1] >> 31);
+            result[0] <<= 1;
+            if (carry) for (uint i = 0; i < words; i++) result[i] ^= polynomial[i];
+        }
+    }
+}
+
+#endif
@@ -46,6 +46,7 @@
 #define PRNGCL_XOR128_CL
 
 #include "prngcl_common.cl"
+#include "prngcl_skip.cl"
 
 #define XOR128_m_FP   (4294967296.0f)
 #define XOR128_min    1
@@ -54,6 +55,9 @@
 #define XOR128_max_FP (4294967295.0/4294967296.0)
 #define XOR128_k      (2.3283064365386962890625E-10) // 1/2^32
 
+// characteristic polynomial of XOR128 transition (without leading x^128 term)
+__constant uint XOR128_polynomial[4] = {0xFD3C8001, 0xF985D65F, 0x0046D8B3, 0x00000001};
+
 //________________________________________________________________________________________________________ XOR128 PRNG
 __attribute__((always_inline)) uint4
 xor128_step(uint4 seed)
@@ -93,40 +97,84 @@ xor128_step_double(uint4* seed)
 }
 #endif
 
-__kernel void
-xor128(__global uint4* seed_table, 
-                     __global hgpu_float4* randoms,
-                     const uint N)
+typedef struct _xor128_state {
+    uint4 seed;
+} xor128_state;
+
+__attribute__((always_inline)) xor128_state
+xor128_state_load(__global uint4* seed_table)
+{
+    xor128_state state;
+    state.seed = seed_table[GID];
+    return state;
+}
+
+__attribute__((always_inline)) void
+xor128_state_store(__global uint4* seed_table,xor128_state* state)
+{
+    seed_table[GID] = (*state).seed;
+}
+
+__attribute__((always_inline)) uint4
+xor128_next_uint4(xor128_state* state)
+{
+    uint4 result;
+    uint4 seed = (*state).seed;
+    seed = xor128_step(seed);
+    result.x = seed.w;
+    seed = xor128_step(seed);
+    result.y = seed.w;
+    seed = xor128_step(seed);
+    result.z = seed.w;
+    seed = xor128_step(seed);
+    result.w = seed.w;
+    (*state).seed = seed;
+    return result;
+}
+
+__attribute__((always_inline)) hgpu_float4
+xor128_next_float4(xor128_state* state)
 {
-    uint giddst = GID;
 #ifdef PRECISION_DOUBLE  // if double precision is defined
     hgpu_double4 result;
+    result.x = xor128_step_double(&(*state).seed);
+    result.y = xor128_step_double(&(*state).seed);
+    result.z = xor128_step_double(&(*state).seed);
+    result.w = xor128_step_double(&(*state).seed);
+    return result;
 #else
-    float4 result;
-    float4 m = (float4) XOR128_m_FP;
+    return hgpu_uint4_to_float4(xor128_next_uint4(state)) / ((float4) XOR128_m_FP);
 #endif
+}
+
+#include "prngcl_distribution.cl"
+
+__kernel void
+xor128(__global uint4* seed_table, 
+                     __global prng_output_t* randoms,
+                     const uint N)
+{
+    xor128_state state = xor128_state_load(seed_table);
+    prng_produce(randoms,&state,N);
+    xor128_state_store(seed_table,&state);
+}
+
+__kernel void
+xor128_skip(__global uint4* seed_table,
+                     const ulong n,
+                     const ulong stride)
+{
+    uint jump[HGPU_SKIP_GF2_MAX_WORDS];
     uint4 seed = seed_table[GID];
-    for (uint i = 0; i < N; i++) {
-#ifdef PRECISION_DOUBLE // if double precision is defined
-        result.x = xor128_step_double(&seed);
-        result.y = xor128_step_double(&seed);
-        result.z = xor128_step_double(&seed);
-        result.w = xor128_step_double(&seed);
-        randoms[giddst] = result;
-#else
-        seed = xor128_step(seed);
-        result.x = (float) seed.w;
-        seed = xor128_step(seed);
-        result.y = (float) seed.w;
-        seed = xor128_step(seed);
-        result.z = (float) seed.w;
+    uint4 result = (uint4) 0;
+
+    // state after n steps is J(T)*state, where J(x) = x^n mod P(x)
+    hgpu_skip_gf2_powmod(XOR128_polynomial, 4, n + stride * GID, jump);
+    for (uint i = 0; i < 128; i++) {
+        if ((jump[i>>5] >> (i&31)) & 1) result ^= seed;
         seed = xor128_step(seed);
-        result.w = (float) seed.w;
-        randoms[giddst] = result / m;
-#endif
-        giddst += GID_SIZE;
     }
-    seed_table[GID] = seed;
+    seed_table[GID] = result;
 }
 
 
@@ -54,6 +54,9 @@
 #define HGPU_PRNG_XOR128_max_FP (4294967295.0/4294967296.0)
 #define HGPU_PRNG_XOR128_k      (2.3283064365386962890625E-10) // 1/2^32
 
+// characteristic polynomial of XOR128 transition (without leading x^128 term)
+static const u32_T HGPU_PRNG_XOR128_polynomial[4] = {0xFD3C8001, 0xF985D65F, 0x0046D8B3, 0x00000001};
+
     typedef struct {
         unsigned int x;
         unsigned int y;
@@ -64,6 +67,7 @@
             static void   HGPU_PRNG_XOR128_initialize(void* PRNG_state, unsigned int PRNG_randseries);
     static unsigned int   HGPU_PRNG_XOR128_produce_one_uint_CPU(void* PRNG_state);
           static double   HGPU_PRNG_XOR128_produce_one_double_CPU(void* PRNG_state);
+            static void   HGPU_PRNG_XOR128_skip_CPU(void* PRNG_state,u64_T n);
             static void   HGPU_PRNG_XOR128_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters);
             static void   HGPU_PRNG_XOR128_parameters_set(void* PRNG_state,HGPU_parameter** parameters);
 
@@ -97,20 +101,33 @@ HGPU_PRNG_XOR128_produce_one_double_CPU(void* PRNG_state){
 	return (y / HGPU_PRNG_XOR128_m);
 }
 
+static void
+HGPU_PRNG_XOR128_skip_CPU(void* PRNG_state,u64_T n){
+    HGPU_PRNG_XOR128_state_t* state = (HGPU_PRNG_XOR128_state_t*) PRNG_state;
+    HGPU_PRNG_XOR128_state_t seed = (*state);
+    u32_T jump[4];
+
+    // state after n steps is J(T)*state, where J(x) = x^n mod P(x)
+    HGPU_PRNG_skip_gf2_powmod(HGPU_PRNG_XOR128_polynomial,4,n,jump);
+    state->x = state->y = state->z = state->t = 0;
+    for (unsigned int i=0; i<128; i++) {
+        if ((jump[i>>5] >> (i&31)) & 1) {
+            state->x ^= seed.x;
+            state->y ^= seed.y;
+            state->z ^= seed.z;
+            state->t ^= seed.t;
+        }
+        HGPU_PRNG_XOR128_produce_one_uint_CPU(&seed);
+    }
+}
+
 static void
 HGPU_PRNG_XOR128_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters){
     HGPU_PRNG_XOR128_state_t* state = (HGPU_PRNG_XOR128_state_t*) PRNG_state;
 
     size_t seed_table_size         = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances);
-    size_t randoms_size            = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * PRNG_parameters->samples);
-    cl_uint4* PRNG_seed_table_uint4= (cl_uint4*)  calloc(seed_table_size,sizeof(cl_uint4));
-    cl_float4*  PRNG_randoms        = NULL;
-    cl_double4* PRNG_randoms_double = NULL;
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        PRNG_randoms_double = (cl_double4*) calloc(randoms_size,sizeof(cl_double4));
-    else
-        PRNG_randoms        = (cl_float4*)  calloc(randoms_size,sizeof(cl_float4));
-    if ((!PRNG_seed_table_uint4) || ((!PRNG_randoms_double) && (!PRNG_randoms)))
+    cl_uint4* PRNG_seed_table_uint4= (cl_uint4*)  HGPU_GPU_context_buffer_host_alloc(context,seed_table_size,sizeof(cl_uint4));
+    if ((!PRNG_seed_table_uint4))
         HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for randoms");
 
     PRNG_seed_table_uint4[0].s[0] = state->x;    // setup first thread as CPU
@@ -125,17 +142,16 @@ HGPU_PRNG_XOR128_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_p
         PRNG_seed_table_uint4[i].s[3] = HGPU_PRNG_rand32bit();
     }
 
+    if (PRNG_parameters->substream)     // substreams of CPU stream are set by skip-ahead kernel
+        for (unsigned int i=1; i<PRNG_parameters->instances; i++) PRNG_seed_table_uint4[i] = PRNG_seed_table_uint4[0];
+
     unsigned int seed_table_id = 0;
     unsigned int randoms_id = 0;
 
     seed_table_id = HGPU_GPU_context_buffer_init(context,PRNG_seed_table_uint4,HGPU_GPU_buffer_type_io,seed_table_size,sizeof(cl_uint4));
     HGPU_GPU_context_buffer_set_name(context,seed_table_id,(char*) "(XOR128) PRNG_seed_table");
 
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms_double,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_double4));
-    else
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_float4));
-    HGPU_GPU_context_buffer_set_name(context,randoms_id,(char*) "(XOR128) PRNG_randoms");
+    randoms_id = HGPU_PRNG_GPU_randoms_init(context,PRNG_parameters,"(XOR128) PRNG_randoms");
 
     PRNG_parameters->id_buffer_input_seeds = HGPU_GPU_MAX_BUFFERS;
     PRNG_parameters->id_buffer_seeds       = seed_table_id;
@@ -175,12 +191,14 @@ HGPU_PRNG_XOR128_description = {
         &HGPU_PRNG_XOR128_parameters_set,             // PRNG additional parameters initialization
         &HGPU_PRNG_XOR128_produce_one_uint_CPU,       // PRNG production one unsigned integer
         &HGPU_PRNG_XOR128_produce_one_double_CPU,     // PRNG production one double
+        &HGPU_PRNG_XOR128_skip_CPU,                   // PRNG skip-ahead
         //
         &HGPU_PRNG_XOR128_init_GPU,                   // PRNG init for GPU procedure
         NULL,                                         // PRNG additional compilation options
         HGPU_PRNG_CL_FILE,                            // PRNG source codes
         NULL,                                         // PRNG init kernel
-        "xor128"                                      // PRNG production kernel
+        "xor128",                                     // PRNG production kernel
+        "xor128_skip"                                 // PRNG skip-ahead kernel
 };
 
 const HGPU_PRNG_description*  HGPU_PRNG_XOR128  = &HGPU_PRNG_XOR128_description;
@@ -46,6 +46,7 @@
 #define PRNGCL_XOR7_CL
 
 #include "prngcl_common.cl"
+#include "prngcl_skip.cl"
 
 #define XOR7_m_FP   (4294967296.0f)
 #define XOR7_min    1
@@ -54,6 +55,10 @@
 #define XOR7_max_FP (4294967295.0/4294967296.0)
 #define XOR7_k      (2.3283064365386962890625E-10) // 1/(2^32-1)
 
+// characteristic polynomial of XOR7 transition (without leading x^256 term)
+__constant uint XOR7_polynomial[8] = {0x9A256CE5, 0x16182BD8, 0xE3C7D29E, 0x560D777A,
+                                      0x5755BBEA, 0x5EA62DEA, 0x7AD437AA, 0x00145113};
+
 __attribute__((always_inline)) void
 xor7_step(uint4* seed1,uint4* seed2)
 {
@@ -96,42 +101,91 @@ xor7_step_double(uint4* seed1,uint4* seed2)
 }
 #endif
 
-__kernel void
-xor7(__global uint4* seed_table, 
-     __global hgpu_float4* randoms,
-       const uint N)
+typedef struct _xor7_state {
+    uint4 seed1;
+    uint4 seed2;
+} xor7_state;
+
+__attribute__((always_inline)) xor7_state
+xor7_state_load(__global uint4* seed_table)
+{
+    xor7_state state;
+    state.seed1 = seed_table[GID];
+    state.seed2 = seed_table[GID + GID_SIZE];
+    return state;
+}
+
+__attribute__((always_inline)) void
+xor7_state_store(__global uint4* seed_table,xor7_state* state)
+{
+    seed_table[GID] = (*state).seed1;
+    seed_table[GID + GID_SIZE] = (*state).seed2;
+}
+
+__attribute__((always_inline)) uint4
+xor7_next_uint4(xor7_state* state)
+{
+    uint4 result;
+    xor7_step(&(*state).seed1,&(*state).seed2);
+        result.x = (*state).seed2.w;
+    xor7_step(&(*state).seed1,&(*state).seed2);
+        result.y = (*state).seed2.w;
+    xor7_step(&(*state).seed1,&(*state).seed2);
+        result.z = (*state).seed2.w;
+    xor7_step(&(*state).seed1,&(*state).seed2);
+        result.w = (*state).seed2.w;
+    return result;
+}
+
+__attribute__((always_inline)) hgpu_float4
+xor7_next_float4(xor7_state* state)
 {
-    uint giddst = GID;
 #ifdef PRECISION_DOUBLE  // if double precision is defined
     hgpu_double4 result;
+    result.x = xor7_step_double(&(*state).seed1,&(*state).seed2);
+    result.y = xor7_step_double(&(*state).seed1,&(*state).seed2);
+    result.z = xor7_step_double(&(*state).seed1,&(*state).seed2);
+    result.w = xor7_step_double(&(*state).seed1,&(*state).seed2);
+    return result;
 #else
-    float4 result;
-    float4 m = (float4) XOR7_m_FP;
+    return hgpu_uint4_to_float4(xor7_next_uint4(state)) / ((float4) XOR7_m_FP);
 #endif
+}
+
+#include "prngcl_distribution.cl"
+
+__kernel void
+xor7(__global uint4* seed_table, 
+     __global prng_output_t* randoms,
+       const uint N)
+{
+    xor7_state state = xor7_state_load(seed_table);
+    prng_produce(randoms,&state,N);
+    xor7_state_store(seed_table,&state);
+}
+
+__kernel void
+xor7_skip(__global uint4* seed_table,
+            const ulong n,
+            const ulong stride)
+{
+    uint jump[HGPU_SKIP_GF2_MAX_WORDS];
     uint4 seed1 = seed_table[GID];
     uint4 seed2 = seed_table[GID + GID_SIZE];
-    for (uint i = 0; i < N; i++) {
-#ifdef PRECISION_DOUBLE // if double precision is defined
-        result.x = xor7_step_double(&seed1,&seed2);
-        result.y = xor7_step_double(&seed1,&seed2);
-        result.z = xor7_step_double(&seed1,&seed2);
-        result.w = xor7_step_double(&seed1,&seed2);
-        randoms[giddst] = result;
-#else
-        xor7_step(&seed1,&seed2);
-            result.x = (float) seed2.w;
-        xor7_step(&seed1,&seed2);
-            result.y = (float) seed2.w;
-        xor7_step(&seed1,&seed2);
-            result.z = (float) seed2.w;
+    uint4 result1 = (uint4) 0;
+    uint4 result2 = (uint4) 0;
+
+    // state after n steps is J(T)*state, where J(x) = x^n mod P(x)
+    hgpu_skip_gf2_powmod(XOR7_polynomial, 8, n + stride * GID, jump);
+    for (uint i = 0; i < 256; i++) {
+        if ((jump[i>>5] >> (i&31)) & 1) {
+            result1 ^= seed1;
+            result2 ^= seed2;
+        }
         xor7_step(&seed1,&seed2);
-            result.w = (float) seed2.w;
-        randoms[giddst] = result / m;
-#endif
-        giddst += GID_SIZE;
     }
-    seed_table[GID] = seed1;
-    seed_table[GID + GID_SIZE] = seed2;
+    seed_table[GID] = result1;
+    seed_table[GID + GID_SIZE] = result2;
 }
 
 
@@ -54,6 +54,10 @@
 #define HGPU_PRNG_XOR7_max_FP (4294967295.0/4294967296.0)
 #define HGPU_PRNG_XOR7_k      (2.3283064365386962890625E-10) // 1/2^32
 
+// characteristic polynomial of XOR7 transition (without leading x^256 term)
+static const u32_T HGPU_PRNG_XOR7_polynomial[8] = {0x9A256CE5, 0x16182BD8, 0xE3C7D29E, 0x560D777A,
+                                                   0x5755BBEA, 0x5EA62DEA, 0x7AD437AA, 0x00145113};
+
     typedef struct {
         unsigned int state[8];
         unsigned int index;
@@ -62,6 +66,7 @@
             static void   HGPU_PRNG_XOR7_initialize(void* PRNG_state, unsigned int PRNG_randseries);
     static unsigned int   HGPU_PRNG_XOR7_produce_one_uint_CPU(void* PRNG_state);
           static double   HGPU_PRNG_XOR7_produce_one_double_CPU(void* PRNG_state);
+            static void   HGPU_PRNG_XOR7_skip_CPU(void* PRNG_state,u64_T n);
             static void   HGPU_PRNG_XOR7_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters);
 
 static void
@@ -100,20 +105,34 @@ HGPU_PRNG_XOR7_produce_one_double_CPU(void* PRNG_state){
 	return (y / HGPU_PRNG_XOR7_m);
 }
 
+static void
+HGPU_PRNG_XOR7_skip_CPU(void* PRNG_state,u64_T n){
+    HGPU_PRNG_XOR7_state_t* state = (HGPU_PRNG_XOR7_state_t*) PRNG_state;
+    HGPU_PRNG_XOR7_state_t seed;
+    u32_T jump[8];
+
+    // rotate state, so state[0] is the oldest word (as in GPU seed table)
+    for (unsigned int k=0; k<8; k++) seed.state[k] = state->state[(state->index+k) & 7];
+    seed.index = 0;
+
+    // state after n steps is J(T)*state, where J(x) = x^n mod P(x)
+    HGPU_PRNG_skip_gf2_powmod(HGPU_PRNG_XOR7_polynomial,8,n,jump);
+    for (unsigned int k=0; k<8; k++) state->state[k] = 0;
+    state->index = 0;
+    for (unsigned int i=0; i<256; i++) {
+        if ((jump[i>>5] >> (i&31)) & 1)
+            for (unsigned int k=0; k<8; k++) state->state[k] ^= seed.state[(seed.index+k) & 7];
+        HGPU_PRNG_XOR7_produce_one_uint_CPU(&seed);
+    }
+}
+
 static void
 HGPU_PRNG_XOR7_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_parameters* PRNG_parameters){
     HGPU_PRNG_XOR7_state_t* state = (HGPU_PRNG_XOR7_state_t*) PRNG_state;
 
     size_t seed_table_size         = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * 2);
-    size_t randoms_size            = HGPU_GPU_context_buffer_size_align(context,PRNG_parameters->instances * PRNG_parameters->samples);
-    cl_uint4* PRNG_seed_table_uint4= (cl_uint4*)  calloc(seed_table_size,sizeof(cl_uint4));
-    cl_float4*  PRNG_randoms        = NULL;
-    cl_double4* PRNG_randoms_double = NULL;
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        PRNG_randoms_double = (cl_double4*) calloc(randoms_size,sizeof(cl_double4));
-    else
-        PRNG_randoms        = (cl_float4*)  calloc(randoms_size,sizeof(cl_float4));
-    if ((!PRNG_seed_table_uint4) || ((!PRNG_randoms_double) && (!PRNG_randoms)))
+    cl_uint4* PRNG_seed_table_uint4= (cl_uint4*)  HGPU_GPU_context_buffer_host_alloc(context,seed_table_size,sizeof(cl_uint4));
+    if ((!PRNG_seed_table_uint4))
         HGPU_error_message(HGPU_ERROR_NO_MEMORY,"could not allocate memory for randoms");
 
     for (unsigned int i=1; i<seed_table_size; i++) {
@@ -133,17 +152,19 @@ HGPU_PRNG_XOR7_init_GPU(HGPU_GPU_context* context,void* PRNG_state,HGPU_PRNG_par
     PRNG_seed_table_uint4[PRNG_parameters->instances].s[2] = state->state[6];
     PRNG_seed_table_uint4[PRNG_parameters->instances].s[3] = state->state[7];
 
+    if (PRNG_parameters->substream)     // substreams of CPU stream are set by skip-ahead kernel
+        for (unsigned int i=1; i<PRNG_parameters->instances; i++) {
+            PRNG_seed_table_uint4[i] = PRNG_seed_table_uint4[0];
+            PRNG_seed_table_uint4[PRNG_parameters->instances + i] = PRNG_seed_table_uint4[PRNG_parameters->instances];
+        }
+
     unsigned int seed_table_id = 0;
     unsigned int randoms_id = 0;
 
     seed_table_id = HGPU_GPU_context_buffer_init(context,PRNG_seed_table_uint4,HGPU_GPU_buffer_type_io,seed_table_size,sizeof(cl_uint4));
     HGPU_GPU_context_buffer_set_name(context,seed_table_id,(char*) "(XOR7) PRNG_seed_table");
 
-    if (PRNG_parameters->precision==HGPU_precision_double)
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms_double,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_double4));
-    else
-        randoms_id = HGPU_GPU_context_buffer_init(context,PRNG_randoms,HGPU_GPU_buffer_type_io,randoms_size,sizeof(cl_float4));
-    HGPU_GPU_context_buffer_set_name(context,randoms_id,(char*) "(XOR7) PRNG_randoms");
+    randoms_id = HGPU_PRNG_GPU_randoms_init(context,PRNG_parameters,"(XOR7) PRNG_randoms");
 
     PRNG_parameters->id_buffer_input_seeds = HGPU_GPU_MAX_BUFFERS;
     PRNG_parameters->id_buffer_seeds       = seed_table_id;
@@ -165,12 +186,14 @@ HGPU_PRNG_XOR7_description = {
         NULL,                                         // PRNG additional parameters initialization
         &HGPU_PRNG_XOR7_produce_one_uint_CPU,         // PRNG production one unsigned integer
         &HGPU_PRNG_XOR7_produce_one_double_CPU,       // PRNG production one double
+        &HGPU_PRNG_XOR7_skip_CPU,                     // PRNG skip-ahead
         //
         &HGPU_PRNG_XOR7_init_GPU,                     // PRNG init for GPU procedure
         NULL,                                         // PRNG additional compilation options
         HGPU_PRNG_CL_FILE,                            // PRNG source codes
         NULL,                                         // PRNG init kernel
-        "xor7"                                        // PRNG production kernel
+        "xor7",                                       // PRNG production kernel
+        "xor7_skip"                                   // PRNG skip-ahead kernel
 };
 
 const HGPU_PRNG_description*  HGPU_PRNG_XOR7  = &HGPU_PRNG_XOR7_description;
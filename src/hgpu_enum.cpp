@@ -84,6 +84,80 @@ HGPU_convert_precision_to_str(HGPU_precision precision){
     return NULL;
 }
 
+HGPU_PRNG_distribution
+HGPU_convert_distribution_from_uint(unsigned int distribution_code){
+    switch(distribution_code){
+        CASE_CODE(0, HGPU_PRNG_distribution_uniform);
+        CASE_CODE(1, HGPU_PRNG_distribution_normal);
+        CASE_CODE(2, HGPU_PRNG_distribution_normal_polar);
+        CASE_CODE(3, HGPU_PRNG_distribution_lognormal);
+        CASE_CODE(4, HGPU_PRNG_distribution_exponential);
+        CASE_CODE(5, HGPU_PRNG_distribution_poisson);
+        CASE_CODE(6, HGPU_PRNG_distribution_gamma);
+        default:
+            return HGPU_PRNG_distribution_uniform;
+            break;
+    }
+}
+
+HGPU_PRNG_distribution
+HGPU_convert_distribution_from_str(const char* distribution){
+    if  (HGPU_string_cmp(distribution,HGPU_PRNG_DISTRIBUTION_NORMAL))       return HGPU_PRNG_distribution_normal;
+    if  (HGPU_string_cmp(distribution,HGPU_PRNG_DISTRIBUTION_NORMAL_POLAR)) return HGPU_PRNG_distribution_normal_polar;
+    if  (HGPU_string_cmp(distribution,HGPU_PRNG_DISTRIBUTION_LOGNORMAL))    return HGPU_PRNG_distribution_lognormal;
+    if  (HGPU_string_cmp(distribution,HGPU_PRNG_DISTRIBUTION_EXPONENTIAL))  return HGPU_PRNG_distribution_exponential;
+    if  (HGPU_string_cmp(distribution,HGPU_PRNG_DISTRIBUTION_POISSON))      return HGPU_PRNG_distribution_poisson;
+    if  (HGPU_string_cmp(distribution,HGPU_PRNG_DISTRIBUTION_GAMMA))        return HGPU_PRNG_distribution_gamma;
+    return HGPU_PRNG_distribution_uniform;
+}
+
+const char*
+HGPU_convert_distribution_to_str(HGPU_PRNG_distribution distribution){
+    const static char* distribution_uniform      = HGPU_PRNG_DISTRIBUTION_UNIFORM;
+    const static char* distribution_normal       = HGPU_PRNG_DISTRIBUTION_NORMAL;
+    const static char* distribution_normal_polar = HGPU_PRNG_DISTRIBUTION_NORMAL_POLAR;
+    const static char* distribution_lognormal    = HGPU_PRNG_DISTRIBUTION_LOGNORMAL;
+    const static char* distribution_exponential  = HGPU_PRNG_DISTRIBUTION_EXPONENTIAL;
+    const static char* distribution_poisson      = HGPU_PRNG_DISTRIBUTION_POISSON;
+    const static char* distribution_gamma        = HGPU_PRNG_DISTRIBUTION_GAMMA;
+    if  (distribution == HGPU_PRNG_distribution_normal)       return distribution_normal;
+    if  (distribution == HGPU_PRNG_distribution_normal_polar) return distribution_normal_polar;
+    if  (distribution == HGPU_PRNG_distribution_lognormal)    return distribution_lognormal;
+    if  (distribution == HGPU_PRNG_distribution_exponential)  return distribution_exponential;
+    if  (distribution == HGPU_PRNG_distribution_poisson)      return distribution_poisson;
+    if  (distribution == HGPU_PRNG_distribution_gamma)        return distribution_gamma;
+    return distribution_uniform;
+}
+
+HGPU_PRNG_output_format
+HGPU_convert_output_format_from_uint(unsigned int output_format_code){
+    switch(output_format_code){
+        CASE_CODE(0, HGPU_PRNG_output_format_float);
+        CASE_CODE(1, HGPU_PRNG_output_format_uint32);
+        CASE_CODE(2, HGPU_PRNG_output_format_uint64);
+        default:
+            return HGPU_PRNG_output_format_float;
+            break;
+    }
+}
+
+HGPU_PRNG_output_format
+HGPU_convert_output_format_from_str(const char* output_format){
+    if  (HGPU_string_cmp(output_format,HGPU_PRNG_OUTPUT_UINT32)) return HGPU_PRNG_output_format_uint32;
+    if  (HGPU_string_cmp(output_format,HGPU_PRNG_OUTPUT_UINT64)) return HGPU_PRNG_output_format_uint64;
+    return HGPU_PRNG_output_format_float;
+}
+
+const char*
+HGPU_convert_output_format_to_str(HGPU_PRNG_output_format output_format){
+    const static char* output_format_float  = HGPU_PRNG_OUTPUT_FLOAT;
+    const static char* output_format_uint32 = HGPU_PRNG_OUTPUT_UINT32;
+    const static char* output_format_uint64 = HGPU_PRNG_OUTPUT_UINT64;
+    if  (output_format == HGPU_PRNG_output_format_uint32) return output_format_uint32;
+    if  (output_format == HGPU_PRNG_output_format_uint64) return output_format_uint64;
+    return output_format_float;
+}
+
 unsigned int
 HGPU_convert_vendor_to_uint(HGPU_GPU_vendor vendor_code){
     switch(vendor_code){
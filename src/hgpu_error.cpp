@@ -93,6 +93,9 @@ HGPU_error_code_to_str(int error_code){
         ERROR_CODE(HGPU_ERROR_BAD_CONTEXT,                      "bad context ptr");
         ERROR_CODE(HGPU_ERROR_BAD_PRNG,                         "bad PRNG");
         ERROR_CODE(HGPU_ERROR_BAD_PRNG_INIT,                    "bad PRNG initializtion");
+        ERROR_CODE(HGPU_ERROR_BAD_PRNG_SKIP,                    "PRNG skip-ahead is not supported");
+        ERROR_CODE(HGPU_ERROR_BAD_PRNG_DISTRIBUTION,            "bad parameters of PRNG output distribution");
+        ERROR_CODE(HGPU_ERROR_BAD_PRNG_OUTPUT,                  "PRNG output format is not supported");
 
         default:
             error_message = "unexpected error";
@@ -209,6 +209,33 @@ HGPU_io_file_write_binary(const char* file_name,const unsigned char* buffer,cons
         HGPU_error_message(HGPU_ERROR_FILE_NOT_FOUND,"error writting binary file");
 }
 
+// write buffer into binary file atomically: buffer is written into temporary file, which is renamed into file_name,
+// so concurrent readers never see partially written file; returns false if file was not written
+bool
+HGPU_io_file_write_binary_atomic(const char* file_name,const unsigned char* buffer,const size_t bytes_to_write){
+    bool result = false;
+    size_t file_name_length = strlen(file_name) + 32;
+    char* file_name_temporary = (char*) calloc(file_name_length,sizeof(char));
+    if (!file_name_temporary) HGPU_error(HGPU_ERROR_NO_MEMORY);
+    sprintf_s(file_name_temporary,file_name_length,"%s.%d.tmp",file_name,(int) _getpid());
+
+    FILE* file_for_write;
+    fopen_s(&file_for_write,file_name_temporary,"wb");
+    if(file_for_write){
+        result = (fwrite(buffer,sizeof(unsigned char),bytes_to_write,file_for_write)==bytes_to_write);
+        if (fclose(file_for_write)) result = false;
+        if ((result) && (rename(file_name_temporary,file_name))) {
+            // rename does not replace existing file on some platforms
+            remove(file_name);
+            result = (!rename(file_name_temporary,file_name));
+        }
+        if (!result) remove(file_name_temporary);
+    }
+    if (!result) HGPU_error_note(HGPU_ERROR_FILE_NOT_FOUND,"error writting binary file");
+    free(file_name_temporary);
+    return result;
+}
+
 // file read and add to existing buffer
 void
 HGPU_io_file_read_add(char** source,const char* file_name){
@@ -256,85 +283,146 @@ HGPU_io_file_read_add_with_path(char** source,const char* file_path,const char*
 
 
 // .inf-files section_____________________________________________________________________________________________
+// program cache is content-addressed: .inf and .bin files are named by cache key (program_<key>.inf, program_<key>.bin)
+
+// get name of cache file with path (HGPU_io_path_inf) for cache key and extension
+void
+HGPU_io_cache_file_get_name(char** file_name,const char* cache_key,const char* extension){
+    char buffer_file[HGPU_FILENAME_MAX];
+    sprintf_s(buffer_file,HGPU_FILENAME_MAX,"program_%s.%s",cache_key,extension);
+    HGPU_io_path_join_filename(file_name,HGPU_FILENAME_MAX,HGPU_io_path_inf,buffer_file);
+}
 
 // delete .inf and .bin files
 int
-HGPU_io_inf_file_delete(int inf_index){
+HGPU_io_inf_file_delete(const char* cache_key){
     int err;
     char* buffer_path = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
-    char* buffer_inf  = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
-    if ((!buffer_inf) || (!buffer_path)) HGPU_error(HGPU_ERROR_NO_MEMORY);
-
-    sprintf_s(buffer_inf,HGPU_FILENAME_MAX,"program%u.inf",inf_index);
-    HGPU_io_path_join_filename(&buffer_path,HGPU_FILENAME_MAX,HGPU_io_path_inf,buffer_inf);
-    err = remove(buffer_path);      // kill .inf-file
-    if (!err){
-        sprintf_s(buffer_inf,HGPU_FILENAME_MAX,"program%u.bin",inf_index);
-        HGPU_io_path_join_filename(&buffer_path,HGPU_FILENAME_MAX,HGPU_io_path_inf,buffer_inf);
-        err = remove(buffer_path);  // kill .bin-file
-    }
-    free(buffer_inf);
+    if (!buffer_path) HGPU_error(HGPU_ERROR_NO_MEMORY);
+
+    HGPU_io_cache_file_get_name(&buffer_path,cache_key,"bin");
+    err = remove(buffer_path);      // kill .bin-file
+    HGPU_io_cache_file_get_name(&buffer_path,cache_key,"inf");
+    remove(buffer_path);            // kill .inf-file
     free(buffer_path);
     return err;
 }
 
-// kill all .inf and .bin files
-void
-HGPU_io_inf_file_delete_all(void){
-    int err = 0;
-    int inf_index = 1;
-    while (!err) err = HGPU_io_inf_file_delete(inf_index++);
+// get name of host (for owner of lock file)
+static void
+HGPU_io_get_host_name(char* host_name,size_t host_name_size){
+    host_name[0] = 0;
+#ifdef _WIN32
+    DWORD size = (DWORD) host_name_size;
+    if (!GetComputerNameA(host_name,&size)) host_name[0] = 0;
+#else
+    if (gethostname(host_name,host_name_size)) host_name[0] = 0;
+    host_name[host_name_size-1] = 0;
+#endif
+    for (char* c=host_name; *c; c++) if (*c==' ') *c = '_';
 }
 
-// rename .inf and .bin files
-int
-HGPU_io_inf_file_rename(int inf_index_old,int inf_index_new){
-    int err = 0;
-    char* buffer_path_old = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
-    char* buffer_path_new = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
-    char* buffer_inf_old  = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
-    char* buffer_inf_new  = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
-    if ((!buffer_path_old) || (!buffer_path_new) || (!buffer_inf_old) || (!buffer_inf_new)) HGPU_error(HGPU_ERROR_NO_MEMORY);
-
-    sprintf_s(buffer_inf_old,HGPU_FILENAME_MAX,"program%u.inf",inf_index_old);
-    HGPU_io_path_join_filename(&buffer_path_old,HGPU_FILENAME_MAX,HGPU_io_path_inf,buffer_inf_old);
-    sprintf_s(buffer_inf_new,HGPU_FILENAME_MAX,"program%u.inf",inf_index_new);
-    HGPU_io_path_join_filename(&buffer_path_new,HGPU_FILENAME_MAX,HGPU_io_path_inf,buffer_inf_new);
-    err = rename(buffer_path_old,buffer_path_new);    // rename .inf-file
-    if (!err) {
-        sprintf_s(buffer_inf_old,HGPU_FILENAME_MAX,"program%u.bin",inf_index_old);
-        HGPU_io_path_join_filename(&buffer_path_old,HGPU_FILENAME_MAX,HGPU_io_path_inf,buffer_inf_old);
-        sprintf_s(buffer_inf_new,HGPU_FILENAME_MAX,"program%u.bin",inf_index_new);
-        HGPU_io_path_join_filename(&buffer_path_new,HGPU_FILENAME_MAX,HGPU_io_path_inf,buffer_inf_new);
-        err = rename(buffer_path_old,buffer_path_new);    // rename .inf-file
+// check if process of this host is running
+static bool
+HGPU_io_process_check_running(int pid){
+#ifdef _WIN32
+    HANDLE process = OpenProcess(SYNCHRONIZE,FALSE,(DWORD) pid);
+    if (!process) return (GetLastError()==ERROR_ACCESS_DENIED);
+    bool result = (WaitForSingleObject(process,0)==WAIT_TIMEOUT);
+    CloseHandle(process);
+    return result;
+#else
+    return ((!kill((pid_t) pid,0)) || (errno==EPERM));
+#endif
+}
+
+// acquire lock of program cache entry (lock file is created exclusively: only one process gets the lock);
+// lock file keeps host name and pid of its owner
+bool
+HGPU_io_lock_file_acquire(const char* cache_key){
+    char* buffer_lock = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
+    if (!buffer_lock) HGPU_error(HGPU_ERROR_NO_MEMORY);
+    HGPU_io_cache_file_get_name(&buffer_lock,cache_key,"lock");
+    char owner[HGPU_MAX_STR_INFO_LENGHT];
+    char host_name[HGPU_MAX_STR_INFO_LENGHT];
+    HGPU_io_get_host_name(host_name,HGPU_MAX_STR_INFO_LENGHT);
+    int owner_length = sprintf_s(owner,HGPU_MAX_STR_INFO_LENGHT,"%s %d\n",host_name,(int) _getpid());
+#ifdef _WIN32
+    int lock_file = _open(buffer_lock,_O_CREAT | _O_EXCL | _O_WRONLY,_S_IREAD | _S_IWRITE);
+    if (lock_file>=0) {
+        _write(lock_file,owner,owner_length);
+        _close(lock_file);
+    }
+#else
+    int lock_file = open(buffer_lock,O_CREAT | O_EXCL | O_WRONLY,S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (lock_file>=0) {
+        ssize_t bytes_written = write(lock_file,owner,owner_length); // lock without owner becomes stale by timeout only
+        (void) bytes_written;
+        close(lock_file);
     }
-    free(buffer_path_old);
-    free(buffer_path_new);
-    free(buffer_inf_old);
-    free(buffer_inf_new);
+#endif
+    free(buffer_lock);
+    return (lock_file>=0);
+}
 
-    return err;
+// get age of lock of program cache entry: seconds since last modification of lock file (negative if there is no lock)
+double
+HGPU_io_lock_file_get_age(const char* cache_key){
+    double result = -1.0;
+    char* buffer_lock = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
+    if (!buffer_lock) HGPU_error(HGPU_ERROR_NO_MEMORY);
+    HGPU_io_cache_file_get_name(&buffer_lock,cache_key,"lock");
+#ifdef _WIN32
+    struct _stat lock_stat;
+    if (!_stat(buffer_lock,&lock_stat)) result = MAX(0.0,difftime(time(NULL),lock_stat.st_mtime));
+#else
+    struct stat lock_stat;
+    if (!stat(buffer_lock,&lock_stat)) result = MAX(0.0,difftime(time(NULL),lock_stat.st_mtime));
+#endif
+    free(buffer_lock);
+    return result;
 }
 
-// get max index of .inf and .bin files
-int
-HGPU_io_inf_file_get_max_index(void){
-    int result = -1;
-    bool flag = true;
-    while(flag){
-        flag = HGPU_io_inf_file_check_existence(result+2);
-        result++;
+// check if owner of lock of program cache entry is a process of this host, which is not running anymore (e.g. crashed)
+bool
+HGPU_io_lock_file_check_orphaned(const char* cache_key){
+    bool result = false;
+    char* buffer_lock = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
+    if (!buffer_lock) HGPU_error(HGPU_ERROR_NO_MEMORY);
+    HGPU_io_cache_file_get_name(&buffer_lock,cache_key,"lock");
+    FILE* lock_file;
+    fopen_s(&lock_file,buffer_lock,"r");
+    if (lock_file) {
+        char owner_host[HGPU_MAX_STR_INFO_LENGHT];
+        char host_name[HGPU_MAX_STR_INFO_LENGHT];
+        int  owner_pid = 0;
+        HGPU_io_get_host_name(host_name,HGPU_MAX_STR_INFO_LENGHT);
+        if ((fscanf(lock_file,"%255s %d",owner_host,&owner_pid)==2) && (!strcmp(owner_host,host_name)) && (owner_pid>0))
+            result = (!HGPU_io_process_check_running(owner_pid));
+        fclose(lock_file);
     }
+    free(buffer_lock);
     return result;
 }
 
-// check .inf file existance
+// release lock of program cache entry
+void
+HGPU_io_lock_file_release(const char* cache_key){
+    char* buffer_lock = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
+    if (!buffer_lock) HGPU_error(HGPU_ERROR_NO_MEMORY);
+    HGPU_io_cache_file_get_name(&buffer_lock,cache_key,"lock");
+    remove(buffer_lock);
+    free(buffer_lock);
+}
+
+// check if program cache entry is locked
 bool
-HGPU_io_inf_file_check_existence(int inf_index){
-    bool result = false;
-    char buffer_inf[HGPU_FILENAME_MAX];
-    sprintf_s(buffer_inf,HGPU_FILENAME_MAX,"program%u.inf",inf_index);
-    result = HGPU_io_file_check_existence_with_path(HGPU_io_path_inf,buffer_inf);
+HGPU_io_lock_file_check_existence(const char* cache_key){
+    char* buffer_lock = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
+    if (!buffer_lock) HGPU_error(HGPU_ERROR_NO_MEMORY);
+    HGPU_io_cache_file_get_name(&buffer_lock,cache_key,"lock");
+    bool result = HGPU_io_file_check_existence(buffer_lock);
+    free(buffer_lock);
     return result;
 }
 
@@ -343,38 +431,39 @@ HGPU_io_inf_file_check_existence(int inf_index){
 
 // check .bin file existance
 bool
-HGPU_io_bin_file_check_existence(int inf_index){
-    bool result = false;
-    char buffer_inf[HGPU_FILENAME_MAX];
-    sprintf_s(buffer_inf,HGPU_FILENAME_MAX,"program%u.bin",inf_index);
-    result = HGPU_io_file_check_existence_with_path(HGPU_io_path_inf,buffer_inf);
+HGPU_io_bin_file_check_existence(const char* cache_key){
+    char* buffer_bin = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
+    if (!buffer_bin) HGPU_error(HGPU_ERROR_NO_MEMORY);
+    HGPU_io_cache_file_get_name(&buffer_bin,cache_key,"bin");
+    bool result = HGPU_io_file_check_existence(buffer_bin);
+    free(buffer_bin);
     return result;
 }
 
-// read .bin-file into buffer
+// read .bin-file into buffer (returns NULL if there is no .bin-file for cache key)
 unsigned char*
-HGPU_io_bin_file_read(int inf_index,size_t* binary_size){
+HGPU_io_bin_file_read(const char* cache_key,size_t* binary_size){
     unsigned char* result = NULL;
     FILE* file_to_read;
     char* buffer_bin = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
-    char* buffer_inf = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
-    if ((!buffer_bin) || (!buffer_inf)) HGPU_error(HGPU_ERROR_NO_MEMORY);
+    if (!buffer_bin) HGPU_error(HGPU_ERROR_NO_MEMORY);
 
-    sprintf_s(buffer_inf,HGPU_FILENAME_MAX,"program%u.bin",inf_index);
-    HGPU_io_path_join_filename(&buffer_bin,HGPU_FILENAME_MAX,HGPU_io_path_inf,buffer_inf);
-    if (HGPU_io_file_check_existence(buffer_bin)) {
-        fopen_s(&file_to_read,buffer_bin,"rb");
+    HGPU_io_cache_file_get_name(&buffer_bin,cache_key,"bin");
+    fopen_s(&file_to_read,buffer_bin,"rb");
+    if (file_to_read) {
         fseek (file_to_read, 0, SEEK_END);
         *binary_size = ftell(file_to_read);
         rewind(file_to_read);
         result = (unsigned char*) calloc ((*binary_size) + 2,sizeof(unsigned char));
         if (!result) HGPU_error(HGPU_ERROR_NO_MEMORY);
         size_t file_read_length = fread(result,1,(*binary_size),file_to_read);
-        if (!file_read_length) free(result);
+        if (!file_read_length) {
+            free(result);
+            result = NULL;
+        }
         if (fclose(file_to_read)) HGPU_error_note(HGPU_ERROR_FILE_NOT_CLOSED,"the file was not closed");
         (*binary_size) = file_read_length;
     }
     free(buffer_bin);
-    free(buffer_inf);
     return result;
 }
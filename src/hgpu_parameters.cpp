@@ -257,6 +257,11 @@ HGPU_parameters_get_from_environment(void){
     HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_WARNING_ERROR);
     HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_NO_CACHE);
     HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_MAX_WORKGROUP_SIZE);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_OUT_OF_ORDER);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_TRANSFER_QUEUE);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_DEVICE_FISSION);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_NO_BUFFER_POOL);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_NO_ZERO_COPY);
     HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_DEVICES_NUMBER);
     HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG);
     HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_RANDSERIES);
@@ -268,6 +273,16 @@ HGPU_parameters_get_from_environment(void){
     HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_SEED3);
     HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_SEED4);
     HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_RANLUX_NSKIP);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_SKIP);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_SUBSTREAM);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_DISTRIBUTION);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_NORMAL_MEAN);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_NORMAL_SIGMA);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_LAMBDA);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_GAMMA_SHAPE);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_GAMMA_SCALE);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_OUTPUT);
+    HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_STREAM);
     HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_TEST_MAX_PASSES);
     HGPU_PARAMETER_INCLUDE(HGPU_PARAMETER_PRNG_TEST_MAX_DURATION);
     return result;
@@ -297,41 +312,20 @@ HGPU_parameters_get_all(int argc, char** argv){
     return result;
 }
 
-// get parameters from .inf-file
-HGPU_parameter**
-HGPU_parameters_get_from_inf_file(int inf_index){
-    char* file_name = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
-    char* buffer_inf = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
-    if ((!file_name) || (!buffer_inf)) HGPU_error(HGPU_ERROR_NO_MEMORY);
-
-    sprintf_s(buffer_inf,HGPU_FILENAME_MAX,"program%u.inf",inf_index);
-    HGPU_io_path_join_filename(&file_name,HGPU_FILENAME_MAX,HGPU_io_path_inf,buffer_inf);
-
-    HGPU_parameter** result = HGPU_parameters_get_from_file(file_name);
-
-    free(buffer_inf);
-    free(file_name);
-    return result;
-}
-
-// write parameters to .inf-file
+// write parameters to .inf-file and binary to .bin-file of program cache (both files are written atomically)
 void
-HGPU_parameters_write_to_inf_file(HGPU_parameter** parameters,const unsigned char* binary,const size_t bytes_in_binary,int inf_index){
+HGPU_parameters_write_to_inf_file(HGPU_parameter** parameters,const unsigned char* binary,const size_t bytes_in_binary,const char* cache_key){
     char* file_name = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
-    char* buffer_inf = (char*) calloc(HGPU_FILENAME_MAX,sizeof(char));
-    if ((!file_name) || (!buffer_inf)) HGPU_error(HGPU_ERROR_NO_MEMORY);
+    if (!file_name) HGPU_error(HGPU_ERROR_NO_MEMORY);
 
-    sprintf_s(buffer_inf,HGPU_FILENAME_MAX,"program%u.inf",inf_index);
-    HGPU_io_path_join_filename(&file_name,HGPU_FILENAME_MAX,HGPU_io_path_inf,buffer_inf);
+    HGPU_io_cache_file_get_name(&file_name,cache_key,"inf");
     char* inf_data = HGPU_parameters_put(parameters);
-    HGPU_io_file_write(file_name,inf_data);
+    HGPU_io_file_write_binary_atomic(file_name,(const unsigned char*) inf_data,strlen(inf_data));
 
-    sprintf_s(buffer_inf,HGPU_FILENAME_MAX,"program%u.bin",inf_index);
-    HGPU_io_path_join_filename(&file_name,HGPU_FILENAME_MAX,HGPU_io_path_inf,buffer_inf);
-    HGPU_io_file_write_binary(file_name,binary,bytes_in_binary);
+    HGPU_io_cache_file_get_name(&file_name,cache_key,"bin");
+    HGPU_io_file_write_binary_atomic(file_name,binary,bytes_in_binary);
 
     free(inf_data);
-    free(buffer_inf);
     free(file_name);
 }
 